@@ -7,6 +7,16 @@
 #include <ctime>
 #include <cmath>
 #include <iomanip>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
 
 // Function to estimate the value of π using Monte Carlo method
 double estimatePi(int samples) {
@@ -27,6 +37,629 @@ double estimatePi(int samples) {
     return 4.0 * insideCircle / samples;
 }
 
+// ---- Counter-based parallel estimator ----
+
+const unsigned PHILOX_LANES = 32;         // counters generated together; the lane loops vectorise
+const uint64_t PI_CHUNK = uint64_t(1) << 20; // samples per work item; fixed, so results never depend on thread count
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// The output is a pure function of a 128-bit counter and a 64-bit key, so
+// there is no hidden state: any position of the stream is reached directly
+// by choosing its counter, which is how threads skip ahead to their chunks.
+struct Philox4x32 {
+    static constexpr uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57; // round multipliers
+    static constexpr uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85; // key schedule (Weyl) increments
+
+    uint32_t k0, k1;
+
+    explicit Philox4x32(uint64_t seed) : k0(uint32_t(seed)), k1(uint32_t(seed >> 32)) {}
+
+    // Four random words for each of the counters {first + lane, c2, c3}, lane = 0..Lanes-1
+    // (the 64-bit index occupies counter words 0 and 1)
+    template<unsigned Lanes>
+    void generate(uint64_t first, uint32_t c2, uint32_t c3, uint32_t out[4][Lanes]) const {
+        uint32_t x0[Lanes], x1[Lanes], x2[Lanes], x3[Lanes];
+        for (unsigned l = 0; l < Lanes; ++l) {
+            uint64_t c = first + l;
+            x0[l] = uint32_t(c);
+            x1[l] = uint32_t(c >> 32);
+            x2[l] = c2;
+            x3[l] = c3;
+        }
+        uint32_t a = k0, b = k1;
+        for (int round = 0; round < 10; ++round) {
+            for (unsigned l = 0; l < Lanes; ++l) {
+                uint64_t p0 = uint64_t(M0) * x0[l];
+                uint64_t p1 = uint64_t(M1) * x2[l];
+                uint32_t y0 = uint32_t(p1 >> 32) ^ x1[l] ^ a;
+                uint32_t y2 = uint32_t(p0 >> 32) ^ x3[l] ^ b;
+                x1[l] = uint32_t(p1);
+                x3[l] = uint32_t(p0);
+                x0[l] = y0;
+                x2[l] = y2;
+            }
+            a += W0;
+            b += W1;
+        }
+        for (unsigned l = 0; l < Lanes; ++l) {
+            out[0][l] = x0[l];
+            out[1][l] = x1[l];
+            out[2][l] = x2[l];
+            out[3][l] = x3[l];
+        }
+    }
+};
+
+// Counts the points among samples [first, last) that land inside the quarter
+// circle. Sample i is half of Philox counter i / 2, so every sample has a
+// fixed position in the stream regardless of who computes it.
+// Coordinates are 31-bit integers and the test x^2 + y^2 <= 2^62 is exact.
+inline uint64_t countInsideCircle(const Philox4x32& rng, uint64_t first, uint64_t last) {
+    const uint64_t R2 = uint64_t(1) << 62;
+    uint32_t words[4][PHILOX_LANES];
+    uint64_t inside = 0;
+    for (uint64_t pair = first / 2; pair * 2 < last; pair += PHILOX_LANES) {
+        rng.generate(pair, 0, 0, words);
+        if ((pair + PHILOX_LANES) * 2 <= last && pair * 2 >= first) {
+            for (unsigned l = 0; l < PHILOX_LANES; ++l) {
+                uint64_t x0 = words[0][l] >> 1, y0 = words[1][l] >> 1;
+                uint64_t x1 = words[2][l] >> 1, y1 = words[3][l] >> 1;
+                inside += (x0 * x0 + y0 * y0 <= R2) + (x1 * x1 + y1 * y1 <= R2);
+            }
+        } else { // Ragged edge: keep only samples inside [first, last)
+            for (unsigned l = 0; l < PHILOX_LANES; ++l)
+                for (unsigned h = 0; h < 2; ++h) {
+                    uint64_t i = (pair + l) * 2 + h;
+                    if (i < first || i >= last) continue;
+                    uint64_t x = words[2 * h][l] >> 1, y = words[2 * h + 1][l] >> 1;
+                    inside += (x * x + y * y <= R2);
+                }
+        }
+    }
+    return inside;
+}
+
+// Estimates π from `samples` points split across threads. Samples are cut into
+// fixed chunks that threads claim from a shared counter. Each sample's random
+// numbers depend only on (seed, index), and the hit counts are exact 64-bit
+// integers, so the same seed gives the same estimate for any num_threads.
+double estimatePiParallel(uint64_t samples, uint64_t seed, unsigned num_threads = 0) {
+    if (samples == 0) return 0;
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    const Philox4x32 rng(seed);
+    const uint64_t chunks = (samples + PI_CHUNK - 1) / PI_CHUNK;
+    std::atomic<uint64_t> next{0};
+    std::vector<uint64_t> inside(num_threads, 0);
+
+    auto work = [&](unsigned t) {
+        uint64_t count = 0;
+        for (uint64_t c = next++; c < chunks; c = next++)
+            count += countInsideCircle(rng, c * PI_CHUNK, std::min(samples, (c + 1) * PI_CHUNK));
+        inside[t] = count;
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < num_threads; ++t) workers.emplace_back(work, t);
+    work(0);
+    for (auto& w : workers) w.join();
+
+    uint64_t total = 0;
+    for (uint64_t n : inside) total += n;
+    return 4.0 * double(total) / double(samples);
+}
+
+// ---- Generic Monte Carlo engine ----
+
+const size_t MC_BATCH = 4096; // samples per work item; fixed, so results never depend on thread count
+
+enum class Variate { Uniform, Normal };
+
+// Branch-free log and sincos for the Box-Muller transform. Unlike the libm
+// calls they inline into the variate loop, which the compiler can then
+// vectorise (given -fno-math-errno, so sqrt needs no errno path).
+// Both are accurate to a few ulp on their domains.
+
+// log(u) for u in (0, 1]: u = m * 2^e with m in [sqrt(1/2), sqrt(2)), and
+// log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172, from its odd series
+inline double logUnit(double u) {
+    uint64_t bits;
+    std::memcpy(&bits, &u, sizeof bits);
+    int64_t e = int64_t(bits >> 52) - 1022; // u = m * 2^e with m in [0.5, 1)
+    bits = (bits & 0x000FFFFFFFFFFFFFull) | 0x3FE0000000000000ull;
+    double m;
+    std::memcpy(&m, &bits, sizeof m);
+    if (m < 0.7071067811865476) { m *= 2; e -= 1; }
+    double s = (m - 1) / (m + 1), s2 = s * s;
+    double p = 1.0 / 21;
+    p = p * s2 + 1.0 / 19;
+    p = p * s2 + 1.0 / 17;
+    p = p * s2 + 1.0 / 15;
+    p = p * s2 + 1.0 / 13;
+    p = p * s2 + 1.0 / 11;
+    p = p * s2 + 1.0 / 9;
+    p = p * s2 + 1.0 / 7;
+    p = p * s2 + 1.0 / 5;
+    p = p * s2 + 1.0 / 3;
+    p = p * s2 + 1.0;
+    return double(e) * 0.6931471805599453 + 2 * s * p;
+}
+
+// sin and cos of 2 pi u: reduce to the nearest quarter turn, evaluate the
+// Taylor polynomials on |x| <= pi/4, then rotate by the quadrant
+inline void sinCosTwoPi(double u, double& sine, double& cosine) {
+    double q = std::nearbyint(4 * u);
+    double x = 6.283185307179586 * (u - 0.25 * q), x2 = x * x;
+    double s = -1.0 / 1307674368000; // -1/15!
+    s = s * x2 + 1.0 / 6227020800;
+    s = s * x2 - 1.0 / 39916800;
+    s = s * x2 + 1.0 / 362880;
+    s = s * x2 - 1.0 / 5040;
+    s = s * x2 + 1.0 / 120;
+    s = s * x2 - 1.0 / 6;
+    s = x + x * x2 * s;
+    double c = 1.0 / 20922789888000; // 1/16!
+    c = c * x2 - 1.0 / 87178291200;
+    c = c * x2 + 1.0 / 479001600;
+    c = c * x2 - 1.0 / 3628800;
+    c = c * x2 + 1.0 / 40320;
+    c = c * x2 - 1.0 / 720;
+    c = c * x2 + 1.0 / 24;
+    c = c * x2 - 0.5;
+    c = 1 + x2 * c;
+    int64_t k = int64_t(q) & 3; // quarter turns: (s, c) -> (c, -s) -> (-s, -c) -> (-c, s)
+    double ps = (k & 1) ? c : s, pc = (k & 1) ? s : c;
+    sine = (k & 2) ? -ps : ps;
+    cosine = ((k + 1) & 2) ? -pc : pc;
+}
+
+// Variates for samples [first, first + count) of one dimension, written to u.
+// Philox counter {k, dim, stream} yields the variates of samples 2k and 2k + 1:
+// two 53-bit uniforms in (0, 1), or a Box-Muller pair of standard normals
+// made from them. first must be even; u must have room for count rounded
+// up to a multiple of 2 * Lanes.
+template<unsigned Lanes>
+void fillVariates(const Philox4x32& rng, Variate kind, uint32_t dim, uint64_t first, size_t count, double* u,
+                  uint32_t stream = 0) {
+    uint32_t words[4][Lanes];
+    double u0[Lanes], u1[Lanes];
+    for (size_t j = 0; j < count; j += 2 * Lanes) {
+        rng.generate(first / 2 + j / 2, dim, stream, words);
+        for (unsigned l = 0; l < Lanes; ++l) {
+            u0[l] = (double(int64_t((uint64_t(words[0][l]) << 32 | words[1][l]) >> 11)) + 0.5) * 0x1p-53;
+            u1[l] = (double(int64_t((uint64_t(words[2][l]) << 32 | words[3][l]) >> 11)) + 0.5) * 0x1p-53;
+        }
+        double* out = u + j;
+        if (kind == Variate::Uniform) {
+            for (unsigned l = 0; l < Lanes; ++l) {
+                out[2 * l] = u0[l];
+                out[2 * l + 1] = u1[l];
+            }
+        } else {
+            for (unsigned l = 0; l < Lanes; ++l) {
+                double r = std::sqrt(-2.0 * logUnit(u0[l]));
+                double sine, cosine;
+                sinCosTwoPi(u1[l], sine, cosine);
+                out[2 * l] = r * cosine;
+                out[2 * l + 1] = r * sine;
+            }
+        }
+    }
+}
+
+// Count, mean and sum of squared deviations of a set of samples. Two sets
+// are combined with Chan et al.'s pairwise update, which stays accurate
+// where accumulating sum and sum of squares would cancel.
+struct MeanVar {
+    uint64_t n = 0;
+    double mean = 0, m2 = 0;
+
+    void merge(const MeanVar& o) {
+        if (o.n == 0) return;
+        uint64_t total = n + o.n;
+        double delta = o.mean - mean;
+        mean += delta * double(o.n) / double(total);
+        m2 += o.m2 + delta * delta * double(n) * double(o.n) / double(total);
+        n = total;
+    }
+    double variance() const { return n > 1 ? m2 / double(n - 1) : 0; }
+};
+
+struct MonteCarloOptions {
+    size_t dimensions = 1;            // variates per sample
+    Variate variate = Variate::Uniform;
+    double tolerance = 1e-3;          // stop when the confidence-interval half-width is below this
+    double z = 1.96;                  // normal quantile of the confidence level (1.96 = 95%)
+    uint64_t min_samples = 1 << 16;   // first round; also guards the variance estimate
+    uint64_t max_samples = uint64_t(1) << 36;
+    uint64_t seed = 1;
+    unsigned threads = 0;             // 0 = hardware concurrency
+    bool simd_variates = true;        // false: generate one Philox counter at a time
+};
+
+struct MonteCarloResult {
+    double estimate = 0;   // mean of the integrand
+    double std_error = 0;  // standard error of the mean
+    double half_width = 0; // z * std_error
+    uint64_t samples = 0;
+    bool converged = false;
+};
+
+// Estimates E[f(U)] for a batch integrand f(u, count, values), where u[d]
+// points to the count variates of dimension d. Samples run in rounds of
+// fixed-size batches that threads claim from a shared counter; each batch is
+// reduced to a MeanVar (two vectorisable passes) in its own slot, and the
+// slots are merged in batch order. After every round the engine stops if
+// the half-width z * sqrt(var / n) meets the tolerance, and otherwise sizes
+// the next round from the current variance (at most doubling the total).
+// Round sizes depend only on merged results, so the estimate is identical
+// for any thread count.
+template <class F>
+MonteCarloResult monteCarlo(F&& batch, const MonteCarloOptions& opt) {
+    const unsigned num_threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+    const Philox4x32 rng(opt.seed);
+    const size_t dims = opt.dimensions;
+    MeanVar total;
+    MonteCarloResult result;
+
+    uint64_t round = (std::max<uint64_t>(opt.min_samples, 1) + MC_BATCH - 1) / MC_BATCH * MC_BATCH;
+    while (total.n < opt.max_samples) {
+        round = std::min(round, opt.max_samples - total.n);
+        const uint64_t first = total.n; // a multiple of MC_BATCH: only the final round can be short
+        const uint64_t batches = (round + MC_BATCH - 1) / MC_BATCH;
+        std::vector<MeanVar> slots(batches);
+        std::atomic<uint64_t> next{0};
+
+        auto work = [&]() {
+            std::vector<double> u(dims * MC_BATCH), values(MC_BATCH);
+            std::vector<const double*> columns(dims);
+            for (size_t d = 0; d < dims; ++d) columns[d] = u.data() + d * MC_BATCH;
+            for (uint64_t b = next++; b < batches; b = next++) {
+                uint64_t start = first + b * MC_BATCH;
+                size_t count = size_t(std::min<uint64_t>(MC_BATCH, first + round - start));
+                for (size_t d = 0; d < dims; ++d) {
+                    if (opt.simd_variates)
+                        fillVariates<PHILOX_LANES>(rng, opt.variate, uint32_t(d), start, count, u.data() + d * MC_BATCH);
+                    else
+                        fillVariates<1>(rng, opt.variate, uint32_t(d), start, count, u.data() + d * MC_BATCH);
+                }
+                batch(columns.data(), count, values.data());
+
+                MeanVar& s = slots[b];
+                double sum = 0;
+                for (size_t j = 0; j < count; ++j) sum += values[j];
+                s.n = count;
+                s.mean = sum / double(count);
+                double m2 = 0;
+                for (size_t j = 0; j < count; ++j) m2 += (values[j] - s.mean) * (values[j] - s.mean);
+                s.m2 = m2;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < num_threads && t < batches; ++t) workers.emplace_back(work);
+        work();
+        for (auto& w : workers) w.join();
+        for (const MeanVar& s : slots) total.merge(s);
+
+        result.estimate = total.mean;
+        result.std_error = std::sqrt(total.variance() / double(total.n));
+        result.half_width = opt.z * result.std_error;
+        result.samples = total.n;
+        if (result.half_width <= opt.tolerance) {
+            result.converged = true;
+            break;
+        }
+        double needed = opt.z * opt.z * total.variance() / (opt.tolerance * opt.tolerance);
+        double more = std::min(std::max(needed - double(total.n), double(MC_BATCH)), double(total.n));
+        round = (uint64_t(more) + MC_BATCH - 1) / MC_BATCH * MC_BATCH;
+    }
+    return result;
+}
+
+// π as a client of the engine: 4 * [x^2 + y^2 <= 1] for uniform (x, y)
+MonteCarloResult estimatePiAdaptive(double tolerance, uint64_t seed, bool simd_variates = true, unsigned num_threads = 0) {
+    MonteCarloOptions opt;
+    opt.dimensions = 2;
+    opt.tolerance = tolerance;
+    opt.seed = seed;
+    opt.threads = num_threads;
+    opt.simd_variates = simd_variates;
+    return monteCarlo([](const double* const* u, size_t count, double* values) {
+        const double* x = u[0];
+        const double* y = u[1];
+        for (size_t j = 0; j < count; ++j) values[j] = (x[j] * x[j] + y[j] * y[j] <= 1.0) ? 4.0 : 0.0;
+    }, opt);
+}
+
+// ---- Quasi-Monte Carlo and variance reduction ----
+
+const size_t QMC_MAX_DIM = 16;
+
+// Sobol direction numbers (Joe & Kuo, new-joe-kuo-6.21201) for dimensions
+// 2..16: degree s and coefficients a of the primitive polynomial, and the
+// initial odd integers m_1..m_s. Dimension 1 is the van der Corput sequence.
+struct SobolPolynomial { unsigned s, a; unsigned m[6]; };
+const SobolPolynomial SOBOL_POLYNOMIALS[QMC_MAX_DIM - 1] = {
+    {1, 0, {1}},                  {2, 1, {1, 3}},               {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},            {4, 1, {1, 1, 3, 3}},         {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},     {5, 4, {1, 1, 5, 5, 5}},      {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},     {5, 13, {1, 1, 1, 3, 11}},    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},  {6, 13, {1, 1, 1, 15, 21, 21}}, {6, 16, {1, 3, 1, 13, 27, 49}},
+};
+
+// 32-bit direction numbers v[d][k] for the first `dims` dimensions
+inline std::vector<std::array<uint32_t, 32>> sobolDirections(size_t dims) {
+    std::vector<std::array<uint32_t, 32>> v(dims);
+    for (unsigned k = 0; k < 32; ++k) v[0][k] = uint32_t(1) << (31 - k);
+    for (size_t d = 1; d < dims; ++d) {
+        const SobolPolynomial& p = SOBOL_POLYNOMIALS[d - 1];
+        for (unsigned k = 0; k < p.s; ++k) v[d][k] = p.m[k] << (31 - k);
+        for (unsigned k = p.s; k < 32; ++k) {
+            uint32_t x = v[d][k - p.s] ^ (v[d][k - p.s] >> p.s);
+            for (unsigned i = 1; i < p.s; ++i)
+                if ((p.a >> (p.s - 1 - i)) & 1) x ^= v[d][k - i];
+            v[d][k] = x;
+        }
+    }
+    return v;
+}
+
+// Scrambled Halton: the radical inverse of n in the d-th prime base, with
+// digit k passed through a random permutation perm[k] of 0..base-1 (all
+// digits down to double precision are scrambled, trailing zeros included).
+// The contribution of the low digits is tabulated, so consecutive points
+// cost one lookup plus a high part that changes only every `low_size` points.
+const unsigned HALTON_PRIMES[QMC_MAX_DIM] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+
+// Philox stream tags (third counter word) for the per-replicate randomisation,
+// apart from the pseudo-random streams 0, 1, 2, ...
+const uint32_t SOBOL_SHIFT_STREAM = 0xFFFFFFFF;
+const uint32_t HALTON_PERM_STREAM = 0xFFFFFFFE;
+
+struct HaltonScramble {
+    unsigned base = 2;
+    std::vector<std::vector<uint8_t>> perm; // perm[k][digit]
+    unsigned low_digits = 1;                // digits covered by the table
+    uint64_t low_size = 1;                  // base^low_digits
+    std::vector<double> low_table;          // scrambled value of the low digits of n % low_size
+
+    HaltonScramble(unsigned base, const Philox4x32& rng, uint32_t replicate, uint32_t dim) : base(base) {
+        unsigned digits = unsigned(std::ceil(53 / std::log2(double(base))));
+        uint32_t words[4][1];
+        perm.resize(digits);
+        for (unsigned k = 0; k < digits; ++k) { // Fisher-Yates shuffle per digit position
+            perm[k].resize(base);
+            for (unsigned i = 0; i < base; ++i) perm[k][i] = uint8_t(i);
+            for (unsigned i = base - 1; i > 0; --i) {
+                rng.generate((uint64_t(replicate) * 64 + k) * 64 + i, dim, HALTON_PERM_STREAM, words);
+                std::swap(perm[k][i], perm[k][words[0][0] % (i + 1)]);
+            }
+        }
+        low_size = base;
+        while (low_size * base <= 4096) {
+            low_size *= base;
+            ++low_digits;
+        }
+        low_table.resize(low_size);
+        for (uint64_t i = 0; i < low_size; ++i) low_table[i] = digitSum(i, 0, low_digits);
+    }
+
+    // Sum of perm[k](digit k of n) / base^(k+1) over k = first_digit..last_digit-1,
+    // where n holds the digits from first_digit upwards
+    double digitSum(uint64_t n, unsigned first_digit, unsigned last_digit) const {
+        double scale = std::pow(double(base), -double(first_digit + 1)), u = 0;
+        for (unsigned k = first_digit; k < last_digit; ++k) {
+            u += perm[k][n % base] * scale;
+            n /= base;
+            scale /= base;
+        }
+        return u;
+    }
+
+    // Points first..first+count-1
+    void fill(uint64_t first, size_t count, double* out) const {
+        uint64_t low = first % low_size, high_index = first / low_size;
+        double high = digitSum(high_index, low_digits, unsigned(perm.size()));
+        for (size_t j = 0; j < count; ++j) {
+            out[j] = low_table[low] + high;
+            if (++low == low_size) {
+                low = 0;
+                high = digitSum(++high_index, low_digits, unsigned(perm.size()));
+            }
+        }
+    }
+};
+
+enum class PointSet { Pseudo, Sobol, Halton };
+
+// Options of the randomised sampler. Every mode is run as `replicates`
+// independent randomisations (Philox streams, Sobol digital shifts, Halton
+// digit scrambles); the spread of the replicate means is the error estimate,
+// valid for any combination of the variance-reduction options below.
+// The sampler produces uniforms on [0, 1)^dimensions; transforming them is
+// up to the integrand.
+struct SamplerOptions {
+    PointSet points = PointSet::Pseudo;
+    size_t dimensions = 1;       // at most QMC_MAX_DIM for Sobol and Halton
+    unsigned replicates = 16;
+    bool antithetic = false;     // also evaluate at 1 - u and average the pair
+    unsigned strata = 1;         // per dimension: sample i uses u -> (cell + u) / strata, cells taken
+                                 // round-robin over strata^dimensions (n must be a multiple of that).
+                                 // Meant for Pseudo points: Sobol and Halton are already
+                                 // stratified, and round-robin cells break their structure.
+    uint64_t seed = 1;
+    unsigned threads = 0;        // 0 = hardware concurrency
+};
+
+struct SamplerResult {
+    double estimate = 0;      // mean of the replicate estimates
+    double std_error = 0;     // their standard deviation / sqrt(replicates)
+    double beta = 0;          // fitted control-variate coefficient (0 without a control)
+    uint64_t evaluations = 0; // integrand calls per sample, times samples
+};
+
+// No control variate
+struct NoControl {};
+
+// Estimates E[f(U)] from n points per replicate. f is a batch integrand as
+// for monteCarlo(). With a control variate g of known mean, f is replaced by
+// f - beta (g - mean_g), beta = cov(f, g) / var(g) pooled over all samples.
+// Work items are (replicate, batch) pairs claimed from a shared counter, each
+// summing into its own slot; slots are added in order, so the result does
+// not depend on the thread count.
+template <class F, class G = NoControl>
+SamplerResult sampleRQMC(F&& f, uint64_t n, const SamplerOptions& opt, G&& control = NoControl{}, double control_mean = 0) {
+    constexpr bool has_control = !std::is_same_v<std::decay_t<G>, NoControl>;
+    const size_t dims = opt.dimensions;
+    if (dims == 0 || opt.replicates < 2 || opt.strata == 0)
+        throw std::invalid_argument("Sampler needs dimensions >= 1, replicates >= 2 and strata >= 1.");
+    if (opt.points != PointSet::Pseudo && dims > QMC_MAX_DIM)
+        throw std::invalid_argument("Sobol and Halton points are tabulated for at most 16 dimensions.");
+    if (opt.points == PointSet::Sobol && n > (uint64_t(1) << 32))
+        throw std::invalid_argument("32-bit Sobol points allow at most 2^32 points per replicate.");
+
+    uint64_t cells = 1;
+    for (size_t d = 0; d < dims; ++d) {
+        if (cells > UINT64_MAX / opt.strata)
+            throw std::invalid_argument("strata^dimensions does not fit in 64 bits.");
+        cells *= opt.strata;
+    }
+    if (n % cells != 0) // a partial round would leave some cells with one sample fewer
+        throw std::invalid_argument("Stratified sampling needs n to be a multiple of strata^dimensions.");
+
+    const unsigned num_threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+    const unsigned R = opt.replicates;
+    const Philox4x32 rng(opt.seed);
+
+    // Per-replicate randomisation
+    std::vector<std::array<uint32_t, 32>> directions;
+    std::vector<std::vector<uint32_t>> shifts(R, std::vector<uint32_t>(dims));
+    std::vector<std::vector<HaltonScramble>> scrambles(R);
+    if (opt.points == PointSet::Sobol) {
+        directions = sobolDirections(dims);
+        uint32_t words[4][1];
+        for (unsigned r = 0; r < R; ++r)
+            for (size_t d = 0; d < dims; ++d) {
+                rng.generate(r, uint32_t(d), SOBOL_SHIFT_STREAM, words);
+                shifts[r][d] = words[0][0];
+            }
+    } else if (opt.points == PointSet::Halton) {
+        for (unsigned r = 0; r < R; ++r)
+            for (size_t d = 0; d < dims; ++d)
+                scrambles[r].emplace_back(HALTON_PRIMES[d], rng, r, uint32_t(d));
+    }
+
+    struct Sums { double f = 0, g = 0, fg = 0, gg = 0; };
+    const uint64_t batches = (n + MC_BATCH - 1) / MC_BATCH;
+    std::vector<Sums> slots(R * batches);
+    std::atomic<uint64_t> next{0};
+
+    auto work = [&]() {
+        const size_t padded = MC_BATCH + 2 * PHILOX_LANES;
+        std::vector<double> u(dims * padded), ua(dims * padded), fv(MC_BATCH), fa(MC_BATCH), gv(MC_BATCH), ga(MC_BATCH);
+        std::vector<const double*> cols(dims), cols_anti(dims);
+        std::vector<unsigned> cell_digits(dims);
+        for (size_t d = 0; d < dims; ++d) {
+            cols[d] = u.data() + d * padded;
+            cols_anti[d] = ua.data() + d * padded;
+        }
+        for (uint64_t item = next++; item < R * batches; item = next++) {
+            const unsigned r = unsigned(item / batches);
+            const uint64_t start = (item % batches) * MC_BATCH;
+            const size_t count = size_t(std::min<uint64_t>(MC_BATCH, n - start));
+
+            for (size_t d = 0; d < dims; ++d) {
+                double* col = u.data() + d * padded;
+                if (opt.points == PointSet::Pseudo) {
+                    fillVariates<PHILOX_LANES>(rng, Variate::Uniform, uint32_t(d), start, count, col, r + 1);
+                } else if (opt.points == PointSet::Sobol) {
+                    // Gray-code order: point i + 1 differs from point i in direction ctz(i + 1)
+                    uint64_t g = start ^ (start >> 1);
+                    uint32_t x = 0;
+                    for (unsigned k = 0; g; ++k, g >>= 1)
+                        if (g & 1) x ^= directions[d][k];
+                    for (size_t j = 0; j < count; ++j) {
+                        col[j] = (double(x ^ shifts[r][d]) + 0.5) * 0x1p-32;
+                        uint64_t next_index = start + j + 1;
+                        unsigned k = 0;
+                        while (k < 31 && !((next_index >> k) & 1)) ++k;
+                        x ^= directions[d][k];
+                    }
+                } else {
+                    scrambles[r][d].fill(start, count, col);
+                }
+            }
+            if (cells > 1) { // Cell digits advance like an odometer, one cell per sample
+                const double width = 1.0 / opt.strata;
+                uint64_t cell = start % cells;
+                for (size_t d = 0; d < dims; ++d) {
+                    cell_digits[d] = unsigned(cell % opt.strata);
+                    cell /= opt.strata;
+                }
+                for (size_t j = 0; j < count; ++j) {
+                    for (size_t d = 0; d < dims; ++d) u[d * padded + j] = (cell_digits[d] + u[d * padded + j]) * width;
+                    for (size_t d = 0; d < dims && ++cell_digits[d] == opt.strata; ++d) cell_digits[d] = 0;
+                }
+            }
+
+            f(cols.data(), count, fv.data());
+            if constexpr (has_control) control(cols.data(), count, gv.data());
+            if (opt.antithetic) {
+                for (size_t d = 0; d < dims; ++d)
+                    for (size_t j = 0; j < count; ++j) ua[d * padded + j] = 1.0 - u[d * padded + j];
+                f(cols_anti.data(), count, fa.data());
+                for (size_t j = 0; j < count; ++j) fv[j] = 0.5 * (fv[j] + fa[j]);
+                if constexpr (has_control) {
+                    control(cols_anti.data(), count, ga.data());
+                    for (size_t j = 0; j < count; ++j) gv[j] = 0.5 * (gv[j] + ga[j]);
+                }
+            }
+
+            Sums& s = slots[item];
+            for (size_t j = 0; j < count; ++j) s.f += fv[j];
+            if constexpr (has_control) {
+                for (size_t j = 0; j < count; ++j) {
+                    double dg = gv[j] - control_mean; // centred, so the sums below do not cancel
+                    s.g += dg;
+                    s.fg += fv[j] * dg;
+                    s.gg += dg * dg;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < num_threads && t < R * batches; ++t) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+
+    // Per-replicate means, then the pooled control coefficient
+    std::vector<Sums> rep(R);
+    for (uint64_t item = 0; item < R * batches; ++item) {
+        Sums& a = rep[item / batches];
+        const Sums& b = slots[item];
+        a.f += b.f; a.g += b.g; a.fg += b.fg; a.gg += b.gg;
+    }
+    SamplerResult result;
+    if constexpr (has_control) {
+        double sf = 0, sg = 0, sfg = 0, sgg = 0, N = double(n) * R;
+        for (const Sums& s : rep) { sf += s.f; sg += s.g; sfg += s.fg; sgg += s.gg; }
+        double var_g = sgg - sg * sg / N;
+        result.beta = var_g > 0 ? (sfg - sf * sg / N) / var_g : 0;
+    }
+    std::vector<double> means(R);
+    for (unsigned r = 0; r < R; ++r) means[r] = (rep[r].f - result.beta * rep[r].g) / double(n);
+
+    double mean = 0, m2 = 0;
+    for (double m : means) mean += m;
+    mean /= R;
+    for (double m : means) m2 += (m - mean) * (m - mean);
+    result.estimate = mean;
+    result.std_error = std::sqrt(m2 / (R - 1) / R);
+    result.evaluations = n * R * (opt.antithetic ? 2 : 1);
+    return result;
+}
+
 int main() {
     srand(static_cast<unsigned int>(time(0))); // Seed the random number generator with current time
 
@@ -45,5 +678,138 @@ int main() {
         std::cout << samples << "\t\t" << estimatedPi << "\t\t" << error << "\n"; // Print results
     }
 
+    // Counter-based parallel estimator: 64-bit sample counts, reproducible from the seed
+    const uint64_t seed = 20240601;
+    std::cout << "\nParallel Philox estimator (seed " << seed << ", "
+              << std::max(1u, std::thread::hardware_concurrency()) << " hardware threads):\n\n";
+    std::cout << "Samples\t\tEstimated Pi\tError\t\tSamples/sec\n";
+    for (uint64_t samples = 1000000; samples <= 1000000000ull; samples *= 10) {
+        auto start = std::chrono::steady_clock::now();
+        double estimatedPi = estimatePiParallel(samples, seed);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << samples << (samples < 10000000 ? "\t\t" : "\t") << estimatedPi << "\t\t"
+                  << std::abs(actualPi - estimatedPi) << "\t" << std::setprecision(2) << std::scientific
+                  << samples / seconds << std::fixed << std::setprecision(6) << "\n";
+    }
+
+    // Same seed, different thread counts: identical estimates
+    std::cout << "\nThread count does not change the result (10^8 samples):\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u})
+        std::cout << "  " << threads << " thread(s): " << std::setprecision(12)
+                  << estimatePiParallel(100000000, seed, threads) << std::setprecision(6) << "\n";
+
+    // Generic engine: run until the 95% confidence interval is narrower than the tolerance
+    std::cout << "\nAdaptive engine, pi to a 95% confidence half-width:\n\n";
+    std::cout << "Tolerance\tEstimated Pi\tError\t\tStd error\tSamples\t\tSamples/sec\n";
+    for (double tol : {1e-2, 3e-3, 1e-3, 3e-4}) {
+        auto start = std::chrono::steady_clock::now();
+        MonteCarloResult r = estimatePiAdaptive(tol, seed);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::scientific << std::setprecision(0) << tol << std::fixed << std::setprecision(6) << "\t\t"
+                  << r.estimate << "\t" << std::abs(actualPi - r.estimate) << "\t" << r.std_error << "\t"
+                  << r.samples << (r.samples < 10000000 ? "\t\t" : "\t") << std::scientific << std::setprecision(2)
+                  << r.samples / seconds << std::fixed << std::setprecision(6) << "\n";
+    }
+
+    // Another client with normal variates: E[exp(Z)] = sqrt(e) for Z ~ N(0, 1)
+    MonteCarloOptions lognormal;
+    lognormal.variate = Variate::Normal;
+    lognormal.tolerance = 1e-3;
+    lognormal.seed = seed;
+    auto expZ = [](const double* const* u, size_t count, double* values) {
+        for (size_t j = 0; j < count; ++j) values[j] = std::exp(u[0][j]);
+    };
+    MonteCarloResult r = monteCarlo(expZ, lognormal);
+    std::cout << "\nE[exp(Z)], Z ~ N(0,1): " << r.estimate << " +/- " << r.half_width
+              << " (exact " << std::sqrt(std::exp(1.0)) << ", " << r.samples << " samples)\n";
+
+    // Variate generation: 32 Philox counters per call (vectorised) against one at a time.
+    // Both produce the same variates, so the estimates are identical.
+    std::cout << "\nSamples/sec with and without the SIMD variate generator (tolerance 1e-3):\n";
+    for (Variate kind : {Variate::Uniform, Variate::Normal}) {
+        double rate[2], estimate[2];
+        for (int simd = 0; simd < 2; ++simd) {
+            auto start = std::chrono::steady_clock::now();
+            MonteCarloResult res;
+            if (kind == Variate::Uniform) {
+                res = estimatePiAdaptive(1e-3, seed, simd == 1);
+            } else {
+                MonteCarloOptions opt = lognormal;
+                opt.simd_variates = simd == 1;
+                res = monteCarlo(expZ, opt);
+            }
+            rate[simd] = res.samples / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            estimate[simd] = res.estimate;
+        }
+        std::cout << "  " << (kind == Variate::Uniform ? "pi (uniform)      " : "E[exp(Z)] (normal)")
+                  << std::scientific << std::setprecision(2) << "   scalar " << rate[0] << "   SIMD " << rate[1]
+                  << std::fixed << std::setprecision(1) << "   x" << rate[1] / rate[0]
+                  << (estimate[0] == estimate[1] ? "   same estimate" : "   ESTIMATES DIFFER") << std::setprecision(6) << "\n";
+    }
+
+    // Quasi-Monte Carlo and variance reduction: error against wall time at
+    // equal integrand evaluations, 16 randomised replicates each
+    auto circle = [](const double* const* u, size_t count, double* values) {
+        for (size_t j = 0; j < count; ++j) values[j] = (u[0][j] * u[0][j] + u[1][j] * u[1][j] <= 1.0) ? 4.0 : 0.0;
+    };
+    auto radius2 = [](const double* const* u, size_t count, double* values) { // control: E[x^2 + y^2] = 2/3
+        for (size_t j = 0; j < count; ++j) values[j] = u[0][j] * u[0][j] + u[1][j] * u[1][j];
+    };
+    struct Mode { const char* name; PointSet points; bool antithetic; unsigned strata; bool control; };
+    const Mode modes[] = {
+        {"Plain pseudo-random", PointSet::Pseudo, false, 1, false},
+        {"Antithetic", PointSet::Pseudo, true, 1, false},
+        {"Control variate", PointSet::Pseudo, false, 1, true},
+        {"Stratified 64x64", PointSet::Pseudo, false, 64, false},
+        {"Strat. + antith. + control", PointSet::Pseudo, true, 64, true},
+        {"Sobol (digital shift)", PointSet::Sobol, false, 1, false},
+        {"Sobol + control", PointSet::Sobol, false, 1, true},
+        {"Halton (scrambled)", PointSet::Halton, false, 1, false},
+    };
+    auto printRow = [&](const char* name, uint64_t evals, const SamplerResult& r, double exact, double ms) {
+        std::cout << "  " << std::left << std::setw(28) << name << std::right << std::setw(10) << evals << "   "
+                  << std::setprecision(9) << r.estimate << std::scientific << std::setprecision(2) << "   "
+                  << std::abs(r.estimate - exact) << "   " << r.std_error << std::fixed << std::setprecision(1)
+                  << std::setw(10) << ms << std::setprecision(6) << "\n";
+    };
+    auto timed = [](auto&& run) {
+        auto start = std::chrono::steady_clock::now();
+        SamplerResult r = run();
+        return std::make_pair(r, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    };
+
+    std::cout << "\nQuasi-Monte Carlo and variance reduction, pi from the quarter circle:\n";
+    std::cout << "  Mode                        Evaluations   Estimate      |Error|    Std error   Time (ms)\n";
+    for (uint64_t evals : {uint64_t(1) << 18, uint64_t(1) << 22, uint64_t(1) << 26}) {
+        for (const Mode& m : modes) {
+            SamplerOptions opt;
+            opt.points = m.points;
+            opt.dimensions = 2;
+            opt.antithetic = m.antithetic;
+            opt.strata = m.strata;
+            opt.seed = seed;
+            const uint64_t n = evals / opt.replicates / (m.antithetic ? 2 : 1);
+            auto [r, ms] = timed([&] {
+                return m.control ? sampleRQMC(circle, n, opt, radius2, 2.0 / 3) : sampleRQMC(circle, n, opt);
+            });
+            printRow(m.name, r.evaluations, r, actualPi, ms);
+        }
+        std::cout << "\n";
+    }
+
+    // A smooth integrand is where QMC shines: pi = integral of 4 / (1 + x^2) over [0, 1]
+    auto arctan = [](const double* const* u, size_t count, double* values) {
+        for (size_t j = 0; j < count; ++j) values[j] = 4.0 / (1.0 + u[0][j] * u[0][j]);
+    };
+    std::cout << "Smooth integrand, pi = integral of 4 / (1 + x^2):\n";
+    for (PointSet points : {PointSet::Pseudo, PointSet::Sobol, PointSet::Halton}) {
+        SamplerOptions opt;
+        opt.points = points;
+        opt.seed = seed;
+        auto [r, ms] = timed([&] { return sampleRQMC(arctan, (uint64_t(1) << 22) / opt.replicates, opt); });
+        printRow(points == PointSet::Pseudo ? "Plain pseudo-random" : points == PointSet::Sobol ? "Sobol (digital shift)" : "Halton (scrambled)",
+                 r.evaluations, r, actualPi, ms);
+    }
+
     return 0; // End program successfully
 }
@@ -6,24 +6,261 @@
 #include <thread>
 #include <vector>
 #include <chrono>
-#include <random>   
-#include <algorithm> 
-#include <memory>  
+#include <random>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+#include <string>
+
+// ==== Control Block Shared by Strong and Weak Pointers ====
+// weak_count holds one extra reference on behalf of all strong owners,
+// so the block outlives the object until the last weak pointer is gone
+struct ControlBlockBase {
+    std::atomic<size_t> weak_count{1};
+
+    virtual ~ControlBlockBase() = default;
+    virtual void destroy_object() = 0;  // delete the managed object (not the block)
+
+    void release_weak() {
+        if (weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+};
+
+// ==== Reference Counting Policy: One Atomic Counter ====
+// Every copy and destroy is an atomic RMW on the same cache line
+struct AtomicRefCount {
+    std::atomic<size_t> strong{1};
+
+    explicit AtomicRefCount(ControlBlockBase*) {}
+
+    void increment() { strong.fetch_add(1, std::memory_order_relaxed); }
+
+    // Returns true when the last strong reference was dropped
+    bool decrement() { return strong.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    // Used by weak pointers: increment only if the object is still alive
+    bool try_increment() {
+        size_t c = strong.load(std::memory_order_relaxed);
+        do {
+            if (c == 0) return false;
+        } while (!strong.compare_exchange_weak(c, c + 1, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+        return true;
+    }
+
+    size_t count() const { return strong.load(std::memory_order_relaxed); }
+};
+
+// ==== Reference Counting Policy: Biased Counting ====
+// The thread that created the object (its owner) counts with plain,
+// non-atomic increments; every other thread uses a shared atomic counter.
+// The two halves are merged once the owner drops its last reference, or
+// earlier when another thread drives the shared half negative (a copy made
+// by the owner was released elsewhere) and queues the block to its owner.
+// The owner settles its queue whenever it creates, drops or locks a biased
+// pointer, and at thread exit. Until then a queued object whose count has
+// reached zero stays alive, e.g. while the owner waits on a join.
+struct BiasedRefCount;
+
+// Per-thread mailbox for blocks waiting to be merged by their owner
+struct BiasedThreadRecord {
+    std::atomic<BiasedRefCount*> merge_queue{nullptr};
+    std::atomic<size_t> refs{1};  // the thread itself + every block biased towards it
+
+    // Marks the queue of a thread that has exited; others then merge for it
+    static BiasedRefCount* closed() { return reinterpret_cast<BiasedRefCount*>(uintptr_t(1)); }
+
+    static BiasedThreadRecord* current();
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    void drain();  // owner only: settle every queued block
+
+    void poll() {
+        BiasedRefCount* head = merge_queue.load(std::memory_order_relaxed);
+        if (head != nullptr && head != closed())
+            drain();
+    }
+    void close();  // owner only, at thread exit
+};
+
+struct BiasedRefCount {
+    // Shared counter layout: count * ONE | QUEUED | MERGED (count may go negative)
+    static constexpr int64_t MERGED = 1;
+    static constexpr int64_t QUEUED = 2;
+    static constexpr int64_t ONE = 4;
+
+    ControlBlockBase* block;
+    BiasedThreadRecord* owner;
+    size_t biased = 1;               // owner-only, non-atomic
+    bool merged = false;             // owner-only (or after the owner has exited)
+    std::atomic<int64_t> shared{0};
+    BiasedRefCount* next = nullptr;  // link in the owner's merge queue
+
+    explicit BiasedRefCount(ControlBlockBase* b) : block(b), owner(BiasedThreadRecord::current()) {
+        owner->refs.fetch_add(1, std::memory_order_relaxed);
+        owner->poll();  // a thread that only creates still settles its queue
+    }
+
+    ~BiasedRefCount() { owner->release(); }
+
+    bool is_owner() const { return owner == BiasedThreadRecord::current(); }
+
+    void increment() {
+        if (is_owner() && !merged)
+            ++biased;
+        else
+            shared.fetch_add(ONE, std::memory_order_relaxed);
+    }
+
+    bool decrement() {
+        if (!is_owner())
+            return shared_decrement();
+
+        bool dead = merged ? shared_decrement() : (--biased == 0 && merge());
+
+        owner->poll();  // cheap check of the mailbox while we are on the owner's fast path
+        return dead;
+    }
+
+    bool try_increment() {
+        if (is_owner()) {
+            owner->poll();  // a pending merge may already have dropped the count to zero
+            if (!merged) {  // unmerged blocks are never destroyed
+                ++biased;
+                return true;
+            }
+        }
+        int64_t v = shared.load(std::memory_order_relaxed);
+        do {
+            if ((v & MERGED) && (v >> 2) == 0) return false;
+        } while (!shared.compare_exchange_weak(v, v + ONE, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+        return true;
+    }
+
+    // Approximate, like std::shared_ptr::use_count: other threads cannot see the biased half
+    size_t count() const {
+        int64_t c = shared.load(std::memory_order_relaxed) >> 2;
+        if (is_owner() && !merged) c += static_cast<int64_t>(biased);
+        return c > 0 ? static_cast<size_t>(c) : 0;
+    }
+
+    // Fold the biased half into the shared counter; true if nothing is left
+    bool merge() {
+        merged = true;
+        int64_t add = static_cast<int64_t>(biased) * ONE + MERGED;
+        biased = 0;
+        return ((shared.fetch_add(add, std::memory_order_acq_rel) + add) >> 2) == 0;
+    }
+
+    // Called for a queued block: merge if still needed, then drop the queue's weak hold
+    void settle() {
+        ControlBlockBase* b = block;
+        if (!merged && merge()) {
+            b->destroy_object();
+            b->release_weak();
+        }
+        b->release_weak();
+    }
+
+private:
+    bool shared_decrement() {
+        int64_t v = shared.fetch_sub(ONE, std::memory_order_acq_rel) - ONE;
+        if (v & MERGED)
+            return (v >> 2) == 0;
+        // Shared half went negative before the merge: ask the owner to merge
+        if ((v >> 2) < 0 && !(v & QUEUED) &&
+            !(shared.fetch_or(QUEUED, std::memory_order_acq_rel) & (QUEUED | MERGED)))
+            enqueue();
+        return false;
+    }
+
+    void enqueue() {
+        block->weak_count.fetch_add(1, std::memory_order_relaxed);  // keep block alive while queued
+        BiasedRefCount* head = owner->merge_queue.load(std::memory_order_acquire);
+        do {
+            if (head == BiasedThreadRecord::closed()) {  // owner has exited, merge on its behalf
+                settle();
+                return;
+            }
+            next = head;
+        } while (!owner->merge_queue.compare_exchange_weak(head, this, std::memory_order_acq_rel,
+                                                           std::memory_order_acquire));
+    }
+};
+
+inline BiasedThreadRecord* BiasedThreadRecord::current() {
+    struct Holder {
+        BiasedThreadRecord* rec = new BiasedThreadRecord;
+        ~Holder() {
+            rec->close();
+            rec->release();
+        }
+    };
+    thread_local Holder holder;
+    return holder.rec;
+}
+
+inline void BiasedThreadRecord::drain() {
+    BiasedRefCount* node = merge_queue.exchange(nullptr, std::memory_order_acq_rel);
+    while (node) {
+        BiasedRefCount* next = node->next;
+        node->settle();
+        node = next;
+    }
+}
+
+inline void BiasedThreadRecord::close() {
+    BiasedRefCount* node = merge_queue.exchange(closed(), std::memory_order_acq_rel);
+    while (node) {
+        BiasedRefCount* next = node->next;
+        node->settle();
+        node = next;
+    }
+}
+
+template <typename T, typename RefCount>
+class LockFreeWeakPtr;
+
+template <typename T, typename Reclaimer, typename RefCount>
+class AtomicSharedPtr;
 
 // ==== Custom Lock-Free Smart Pointer Class ====
-template <typename T>
+template <typename T, typename RefCount = AtomicRefCount>
 class LockFreeSharedPtr {
 private:
-    // Control block holds a pointer and an atomic reference counter
-    struct ControlBlock {
-        std::atomic<size_t> ref_count;
+    // Control block holds a pointer and the reference counter policy
+    struct ControlBlock : ControlBlockBase {
         T* ptr;
+        RefCount counter;
 
-        ControlBlock(T* p) : ref_count(1), ptr(p) {}
+        ControlBlock(T* p) : ptr(p), counter(this) {}
+        void destroy_object() override { delete ptr; }
     };
 
     ControlBlock* control;  // Points to the shared control block
 
+    // Adopt a reference that was already counted (used by LockFreeWeakPtr::lock)
+    struct AdoptTag {};
+    LockFreeSharedPtr(ControlBlock* c, AdoptTag) : control(c) {}
+
+    void release() {
+        if (control && control->counter.decrement()) {
+            control->destroy_object();
+            control->release_weak();
+        }
+        control = nullptr;
+    }
+
+    friend class LockFreeWeakPtr<T, RefCount>;
+    template <typename, typename, typename>
+    friend class AtomicSharedPtr;
+
 public:
     // Constructor: create control block if pointer is given
     explicit LockFreeSharedPtr(T* p = nullptr) {
@@ -37,7 +274,7 @@ public:
     LockFreeSharedPtr(const LockFreeSharedPtr& other) {
         control = other.control;
         if (control) {
-            control->ref_count.fetch_add(1, std::memory_order_relaxed);
+            control->counter.increment();
         }
     }
 
@@ -50,47 +287,551 @@ public:
     // Copy assignment
     LockFreeSharedPtr& operator=(const LockFreeSharedPtr& other) {
         if (this != &other) {
-            this->~LockFreeSharedPtr();  // cleanup current
+            release();  // cleanup current
             control = other.control;
             if (control) {
-                control->ref_count.fetch_add(1, std::memory_order_relaxed);
+                control->counter.increment();
             }
         }
         return *this;
     }
 
-    // Destructor: decrement ref count, delete if last reference
-    ~LockFreeSharedPtr() {
-        if (control) {
-            if (control->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-                delete control->ptr;
-                delete control;
-            }
+    // Move assignment
+    LockFreeSharedPtr& operator=(LockFreeSharedPtr&& other) noexcept {
+        if (this != &other) {
+            release();
+            control = other.control;
+            other.control = nullptr;
         }
+        return *this;
     }
 
+    // Destructor: decrement ref count, delete if last reference
+    ~LockFreeSharedPtr() { release(); }
+
     // Accessor methods
     T* get() const { return control ? control->ptr : nullptr; }
     T& operator*() const { return *get(); }
     T* operator->() const { return get(); }
+    explicit operator bool() const { return get() != nullptr; }
 
     // Returns how many references exist
     size_t use_count() const {
-        return control ? control->ref_count.load(std::memory_order_relaxed) : 0;
+        return control ? control->counter.count() : 0;
+    }
+};
+
+// Biased mode: owner-thread copies never touch an atomic
+template <typename T>
+using BiasedSharedPtr = LockFreeSharedPtr<T, BiasedRefCount>;
+
+// ==== Weak Pointer: Observes Without Keeping the Object Alive ====
+template <typename T, typename RefCount = AtomicRefCount>
+class LockFreeWeakPtr {
+private:
+    using Shared = LockFreeSharedPtr<T, RefCount>;
+    typename Shared::ControlBlock* control = nullptr;
+
+    void release() {
+        if (control) control->release_weak();
+        control = nullptr;
+    }
+
+public:
+    LockFreeWeakPtr() = default;
+
+    LockFreeWeakPtr(const Shared& shared) : control(shared.control) {
+        if (control) control->weak_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LockFreeWeakPtr(const LockFreeWeakPtr& other) : control(other.control) {
+        if (control) control->weak_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LockFreeWeakPtr(LockFreeWeakPtr&& other) noexcept : control(other.control) {
+        other.control = nullptr;
+    }
+
+    LockFreeWeakPtr& operator=(const LockFreeWeakPtr& other) {
+        if (this != &other) {
+            release();
+            control = other.control;
+            if (control) control->weak_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    ~LockFreeWeakPtr() { release(); }
+
+    // Returns a strong pointer, or an empty one if the object is already gone
+    Shared lock() const {
+        if (control && control->counter.try_increment())
+            return Shared(control, typename Shared::AdoptTag{});
+        return Shared();
+    }
+
+    size_t use_count() const { return control ? control->counter.count() : 0; }
+    bool expired() const { return !lock().get(); }
+};
+
+// ==== Memory Reclamation: Epoch-Based (EBR) ====
+// Readers pin the global epoch with a Guard; unlinked nodes are retired
+// into a per-thread list tagged with the epoch and freed once the global
+// epoch has advanced twice, i.e. once no pinned reader can still see them.
+// Readers are cheap (one store + fence), but a reader that stays pinned
+// stops the epoch, so garbage is bounded by making retiring threads wait.
+class EpochReclaimer {
+private:
+    struct ThreadRecord;
+
+public:
+    static constexpr size_t collect_threshold = 64;  // retire-list length that triggers a collection
+    static constexpr size_t garbage_bound = 4096;    // above this, leaving a guard waits for readers
+
+    // RAII pin of the current epoch; guards may nest
+    class Guard {
+    public:
+        Guard() : rec(local()) {
+            if (rec->nesting++ == 0) {
+                rec->epoch.store((global_epoch.load(std::memory_order_relaxed) << 1) | 1,
+                                 std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        ~Guard() {
+            if (--rec->nesting == 0) {
+                rec->epoch.store(0, std::memory_order_release);
+                while (rec->retired.size() > garbage_bound) {
+                    collect(rec);
+                    if (rec->retired.size() > garbage_bound) std::this_thread::yield();
+                }
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        // Pinned readers may simply load: nothing they can reach is freed
+        template <typename T>
+        T* protect(const std::atomic<T*>& src, int /*slot*/ = 0) {
+            return src.load(std::memory_order_acquire);
+        }
+
+    private:
+        ThreadRecord* rec;
+    };
+
+    template <typename T>
+    static void retire(T* p) {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    static void retire(void* p, void (*deleter)(void*)) {
+        ThreadRecord* rec = local();
+        uint64_t tag = global_epoch.load(std::memory_order_seq_cst);
+        rec->retired.push_back({p, deleter, tag});
+        if (rec->retired.size() % collect_threshold == 0)
+            collect(rec);
+    }
+
+    // Frees every retired node; only call when no other thread uses the structures
+    static void quiesce() {
+        for (ThreadRecord* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            for (auto& item : r->retired)
+                item.deleter(item.ptr);
+            r->retired.clear();
+        }
+    }
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    struct alignas(64) ThreadRecord {
+        std::atomic<uint64_t> epoch{0};  // (pinned epoch << 1) | 1 while in a guard, 0 otherwise
+        std::atomic<bool> in_use{true};
+        ThreadRecord* next = nullptr;
+        unsigned nesting = 0;
+        std::vector<Retired> retired;
+    };
+
+    inline static std::atomic<uint64_t> global_epoch{0};
+    inline static std::atomic<ThreadRecord*> records{nullptr};
+
+    // Records are never freed; a thread adopts a released one (and its garbage) if it can
+    static ThreadRecord* local() {
+        struct Holder {
+            ThreadRecord* rec;
+            Holder() {
+                for (rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+                    bool expected = false;
+                    if (rec->in_use.compare_exchange_strong(expected, true)) return;
+                }
+                rec = new ThreadRecord;
+                rec->next = records.load(std::memory_order_relaxed);
+                while (!records.compare_exchange_weak(rec->next, rec, std::memory_order_release,
+                                                      std::memory_order_relaxed)) {}
+            }
+            ~Holder() {
+                collect(rec);
+                rec->in_use.store(false, std::memory_order_release);
+            }
+        };
+        thread_local Holder holder;
+        return holder.rec;
+    }
+
+    // Advance the epoch if every pinned thread has caught up with it
+    static uint64_t try_advance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t g = global_epoch.load(std::memory_order_seq_cst);
+        for (ThreadRecord* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            uint64_t e = r->epoch.load(std::memory_order_seq_cst);
+            if ((e & 1) && (e >> 1) != g) return g;
+        }
+        global_epoch.compare_exchange_strong(g, g + 1, std::memory_order_seq_cst);
+        return global_epoch.load(std::memory_order_seq_cst);
+    }
+
+    static void collect(ThreadRecord* rec) {
+        uint64_t g = try_advance();
+        auto safe = std::partition(rec->retired.begin(), rec->retired.end(),
+                                   [g](const Retired& item) { return item.epoch + 2 > g; });
+        for (auto it = safe; it != rec->retired.end(); ++it)
+            it->deleter(it->ptr);
+        rec->retired.erase(safe, rec->retired.end());
+    }
+};
+
+// ==== Memory Reclamation: Hazard Pointers ====
+// Readers publish each pointer they dereference in a per-thread slot;
+// a retired node is freed once no slot holds it. Costlier per access than
+// EBR, but a stalled or long-running reader only keeps its own few nodes
+// alive, so garbage stays bounded at scan_threshold + threads * slots.
+class HazardPointerReclaimer {
+private:
+    struct ThreadRecord;
+
+public:
+    static constexpr int slots_per_thread = 2;
+    static constexpr size_t scan_threshold = 64;
+
+    // Owns this thread's hazard slots; one Guard per thread at a time
+    class Guard {
+    public:
+        Guard() : rec(local()) {}
+
+        ~Guard() {
+            for (auto& slot : rec->hazards)
+                slot.store(nullptr, std::memory_order_release);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        // Publish the pointer, then re-read to make sure it was not retired meanwhile
+        template <typename T>
+        T* protect(const std::atomic<T*>& src, int slot = 0) {
+            T* p = src.load(std::memory_order_relaxed);
+            while (true) {
+                rec->hazards[slot].store(p, std::memory_order_seq_cst);
+                T* again = src.load(std::memory_order_seq_cst);
+                if (again == p) return p;
+                p = again;
+            }
+        }
+
+    private:
+        ThreadRecord* rec;
+    };
+
+    template <typename T>
+    static void retire(T* p) {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    static void retire(void* p, void (*deleter)(void*)) {
+        ThreadRecord* rec = local();
+        rec->retired.push_back({p, deleter});
+        if (rec->retired.size() >= scan_threshold)
+            scan(rec);
+    }
+
+    // Frees every retired node; only call when no other thread uses the structures
+    static void quiesce() {
+        for (ThreadRecord* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            for (auto& item : r->retired)
+                item.deleter(item.ptr);
+            r->retired.clear();
+        }
+    }
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    struct alignas(64) ThreadRecord {
+        std::atomic<void*> hazards[slots_per_thread] = {};
+        std::atomic<bool> in_use{true};
+        ThreadRecord* next = nullptr;
+        std::vector<Retired> retired;
+    };
+
+    inline static std::atomic<ThreadRecord*> records{nullptr};
+
+    static ThreadRecord* local() {
+        struct Holder {
+            ThreadRecord* rec;
+            Holder() {
+                for (rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+                    bool expected = false;
+                    if (rec->in_use.compare_exchange_strong(expected, true)) return;
+                }
+                rec = new ThreadRecord;
+                rec->next = records.load(std::memory_order_relaxed);
+                while (!records.compare_exchange_weak(rec->next, rec, std::memory_order_release,
+                                                      std::memory_order_relaxed)) {}
+            }
+            ~Holder() {
+                scan(rec);
+                rec->in_use.store(false, std::memory_order_release);
+            }
+        };
+        thread_local Holder holder;
+        return holder.rec;
+    }
+
+    static void scan(ThreadRecord* rec) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<void*> protected_ptrs;
+        for (ThreadRecord* r = records.load(std::memory_order_acquire); r; r = r->next)
+            for (auto& slot : r->hazards)
+                if (void* p = slot.load(std::memory_order_seq_cst)) protected_ptrs.push_back(p);
+        std::sort(protected_ptrs.begin(), protected_ptrs.end());
+
+        auto safe = std::partition(rec->retired.begin(), rec->retired.end(), [&](const Retired& item) {
+            return std::binary_search(protected_ptrs.begin(), protected_ptrs.end(), item.ptr);
+        });
+        for (auto it = safe; it != rec->retired.end(); ++it)
+            it->deleter(it->ptr);
+        rec->retired.erase(safe, rec->retired.end());
+    }
+};
+
+// ==== Atomic Shared Pointer (like std::atomic<std::shared_ptr>) ====
+// The reference held by the atomic slot is released through the reclaimer,
+// so a reader that protected the control block can always add its own
+// reference without racing the block's destruction.
+template <typename T, typename Reclaimer = EpochReclaimer, typename RefCount = AtomicRefCount>
+class AtomicSharedPtr {
+private:
+    using Shared = LockFreeSharedPtr<T, RefCount>;
+    using ControlBlock = typename Shared::ControlBlock;
+
+    std::atomic<ControlBlock*> control{nullptr};
+
+    static void retire_reference(ControlBlock* c) {
+        Reclaimer::retire(c, [](void* p) {
+            Shared(static_cast<ControlBlock*>(p), typename Shared::AdoptTag{});  // drops the reference
+        });
+    }
+
+    static ControlBlock* take(Shared& s) {
+        ControlBlock* c = s.control;
+        s.control = nullptr;
+        return c;
+    }
+
+public:
+    AtomicSharedPtr() = default;
+    explicit AtomicSharedPtr(Shared desired) : control(take(desired)) {}
+
+    AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    // Not concurrent with other operations
+    ~AtomicSharedPtr() { Shared(control.load(std::memory_order_acquire), typename Shared::AdoptTag{}); }
+
+    Shared load() const {
+        typename Reclaimer::Guard guard;
+        ControlBlock* c = guard.protect(control, 0);
+        if (!c) return Shared();
+        c->counter.increment();
+        return Shared(c, typename Shared::AdoptTag{});
+    }
+
+    void store(Shared desired) {
+        ControlBlock* old = control.exchange(take(desired), std::memory_order_acq_rel);
+        if (old) retire_reference(old);
+    }
+
+    Shared exchange(Shared desired) {
+        ControlBlock* old = control.exchange(take(desired), std::memory_order_acq_rel);
+        if (!old) return Shared();
+        old->counter.increment();  // caller's copy; the slot's own reference is retired
+        retire_reference(old);
+        return Shared(old, typename Shared::AdoptTag{});
+    }
+
+    // expected holds a reference, so its control block cannot be reused (no ABA)
+    bool compare_exchange_strong(Shared& expected, Shared desired) {
+        ControlBlock* exp = expected.control;
+        if (control.compare_exchange_strong(exp, desired.control, std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            take(desired);  // the slot now owns desired's reference
+            if (exp) retire_reference(exp);
+            return true;
+        }
+        expected = load();
+        return false;
+    }
+};
+
+// ==== Lock-Free Stack (Treiber) ====
+template <typename T, typename Reclaimer = EpochReclaimer>
+class LockFreeStack {
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head{nullptr};
+
+public:
+    LockFreeStack() = default;
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    ~LockFreeStack() {
+        Node* n = head.load(std::memory_order_acquire);
+        while (n) {
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    void push(T value) {
+        Node* n = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(n->next, n, std::memory_order_release,
+                                           std::memory_order_relaxed)) {}
+    }
+
+    bool pop(T& out) {
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* h = guard.protect(head, 0);
+            if (!h) return false;
+            // h cannot be freed (and so cannot reappear as head) while protected: no ABA
+            if (head.compare_exchange_weak(h, h->next, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                out = std::move(h->value);
+                Reclaimer::retire(h);
+                return true;
+            }
+        }
+    }
+};
+
+// ==== Lock-Free Queue (Michael-Scott) ====
+template <typename T, typename Reclaimer = EpochReclaimer>
+class LockFreeQueue {
+private:
+    struct Node {
+        T value{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    // head always points at a dummy node; the front value lives in head->next
+    alignas(64) std::atomic<Node*> head;
+    alignas(64) std::atomic<Node*> tail;
+
+public:
+    LockFreeQueue() {
+        Node* dummy = new Node;
+        head.store(dummy, std::memory_order_relaxed);
+        tail.store(dummy, std::memory_order_relaxed);
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    ~LockFreeQueue() {
+        Node* n = head.load(std::memory_order_acquire);
+        while (n) {
+            Node* next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+
+    void push(T value) {
+        Node* n = new Node;
+        n->value = std::move(value);
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* t = guard.protect(tail, 0);
+            Node* next = t->next.load(std::memory_order_acquire);
+            if (t != tail.load(std::memory_order_acquire)) continue;
+            if (next == nullptr) {
+                if (t->next.compare_exchange_weak(next, n, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+                    tail.compare_exchange_strong(t, n, std::memory_order_release,
+                                                 std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                tail.compare_exchange_strong(t, next, std::memory_order_release,
+                                             std::memory_order_relaxed);  // help a lagging tail
+            }
+        }
+    }
+
+    bool pop(T& out) {
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* h = guard.protect(head, 0);
+            Node* t = tail.load(std::memory_order_acquire);
+            Node* next = guard.protect(h->next, 1);
+            if (h != head.load(std::memory_order_acquire)) continue;
+            if (next == nullptr) return false;
+            if (h == t) {
+                tail.compare_exchange_strong(t, next, std::memory_order_release,
+                                             std::memory_order_relaxed);
+                continue;
+            }
+            if (head.compare_exchange_strong(h, next, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+                out = std::move(next->value);  // next becomes the new dummy
+                Reclaimer::retire(h);
+                return true;
+            }
+        }
     }
 };
 
 // ==== Simple Test Object ====
 struct TestData {
+    static std::atomic<long> live;  // Detects leaks and double frees
     int value;
-    TestData(int v) : value(v) {}
+    TestData(int v = 0) : value(v) { live.fetch_add(1, std::memory_order_relaxed); }
+    ~TestData() { live.fetch_sub(1, std::memory_order_relaxed); }
 };
+std::atomic<long> TestData::live{0};
 
 // ==== Function to Test Copies & Shuffling in Threads ====
+template <typename RefCount = AtomicRefCount>
 void stress_test(int thread_id, int iterations) {
     for (int i = 0; i < iterations; ++i) {
-        LockFreeSharedPtr<TestData> ptr(new TestData(i));  // create shared pointer
-        std::vector<LockFreeSharedPtr<TestData>> copies;
+        LockFreeSharedPtr<TestData, RefCount> ptr(new TestData(i));  // create shared pointer
+        std::vector<LockFreeSharedPtr<TestData, RefCount>> copies;
 
         // Create multiple copies of the same pointer
         for (int j = 0; j < 10; ++j) {
@@ -104,6 +845,32 @@ void stress_test(int thread_id, int iterations) {
     }
 }
 
+// ==== Hand Copies to Other Threads and Race Weak Locks Against Release ====
+// Exercises the biased merge path: copies made by the owner die on other threads
+template <typename RefCount>
+void cross_thread_test(int iterations) {
+    using Ptr = LockFreeSharedPtr<TestData, RefCount>;
+    for (int i = 0; i < iterations; ++i) {
+        Ptr owner_ptr(new TestData(i));
+        LockFreeWeakPtr<TestData, RefCount> weak(owner_ptr);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([copy = owner_ptr, weak]() mutable {
+                for (int k = 0; k < 50; ++k) {
+                    Ptr locked = weak.lock();
+                    if (locked && locked->value < 0) std::abort();  // must see a live object
+                }
+                copy = Ptr();  // release the owner's copy on this thread
+            });
+        }
+        owner_ptr = Ptr();  // owner may drop its reference before the others
+        for (auto& t : threads)
+            t.join();
+        if (!weak.expired()) std::abort();
+    }
+}
+
 // ==== Benchmark Shared Pointer Creation Across Threads ====
 template <typename SmartPtrFactory>
 void benchmark(const std::string& label, SmartPtrFactory smart_ptr_factory) {
@@ -136,6 +903,131 @@ void benchmark(const std::string& label, SmartPtrFactory smart_ptr_factory) {
     std::cout << label << " Time: " << dur.count() << " seconds\n";
 }
 
+// ==== Copy Throughput Scaling From 1 to 64 Threads ====
+// "own": each thread copies and drops a pointer to an object it created
+// itself, the common case biased counting is designed for. "shared": the
+// main thread creates one pointer and every thread copies it, so all copies
+// go through the same shared counter.
+template <typename Ptr>
+void scaling_benchmark(const std::string& label) {
+    const long copies_per_thread = 200000;
+
+    auto run = [&](int num_threads, bool shared) {
+        Ptr common(new TestData(-1));
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < num_threads; ++i)
+            threads.emplace_back([&, i]() {
+                Ptr ptr = shared ? common : Ptr(new TestData(i));
+                int expected = shared ? -1 : i;
+                for (long k = 0; k < copies_per_thread; ++k) {
+                    Ptr copy(ptr);
+                    if (copy->value != expected) std::abort();
+                }
+            });
+        for (auto& t : threads)
+            t.join();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> dur = end - start;
+        return num_threads * copies_per_thread / dur.count() / 1e6;
+    };
+
+    std::cout << label << ":\n";
+    for (int num_threads = 1; num_threads <= 64; num_threads *= 2) {
+        double own = run(num_threads, false);
+        double shared = run(num_threads, true);
+        std::cout << "  " << num_threads << " threads: " << own << " M copies/sec own, "
+                  << shared << " M copies/sec shared\n";
+    }
+}
+
+// ==== Lock-Free Stack Stress Test: Every Value Pops Exactly Once ====
+template <typename Reclaimer>
+void stack_stress_test(int num_threads, int per_thread) {
+    LockFreeStack<int, Reclaimer> stack;
+    std::vector<std::atomic<int>> seen(num_threads * per_thread);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+        threads.emplace_back([&, t]() {
+            int value;
+            for (int i = 0; i < per_thread; ++i) {
+                stack.push(t * per_thread + i);
+                if (i % 2 == 1 && stack.pop(value))  // interleave pops with pushes
+                    seen[value].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+
+    int value;
+    while (stack.pop(value))
+        seen[value].fetch_add(1, std::memory_order_relaxed);
+    for (auto& s : seen)
+        if (s.load() != 1) std::abort();
+}
+
+// ==== Lock-Free Queue Stress Test: Nothing Lost, FIFO Per Producer ====
+template <typename Reclaimer>
+void queue_stress_test(int producers, int consumers, int per_producer) {
+    LockFreeQueue<TestData, Reclaimer> queue;
+    std::atomic<int> consumed{0};
+    const int total = producers * per_producer;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; ++i)
+                queue.push(TestData(p * per_producer + i));
+        });
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&]() {
+            std::vector<int> last(producers, -1);  // last sequence seen from each producer
+            TestData item;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (!queue.pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                int p = item.value / per_producer, seq = item.value % per_producer;
+                if (seq <= last[p]) std::abort();
+                last[p] = seq;
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+
+    TestData item;
+    if (consumed.load() != total || queue.pop(item)) std::abort();
+}
+
+// ==== AtomicSharedPtr Stress Test: Concurrent Loads and CAS Increments ====
+// Every successful CAS adds 7, so the final value must equal 7 * successes
+template <typename Reclaimer>
+void atomic_ptr_stress_test(int num_threads, int iterations) {
+    using Ptr = LockFreeSharedPtr<TestData>;
+    AtomicSharedPtr<TestData, Reclaimer> slot(Ptr(new TestData(0)));
+    std::atomic<int> successes{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+        threads.emplace_back([&]() {
+            for (int i = 0; i < iterations; ++i) {
+                Ptr current = slot.load();
+                if (current->value % 7 != 0) std::abort();
+                if (slot.compare_exchange_strong(current, Ptr(new TestData(current->value + 7))))
+                    successes.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+
+    if (slot.load()->value != 7 * successes.load()) std::abort();
+}
+
 // ==== Main Function ====
 int main() {
     std::cout << "=== Stress Testing Lock-Free Smart Pointer ===\n";
@@ -143,16 +1035,43 @@ int main() {
         // Run multiple threads to test reliability under load
         std::vector<std::thread> threads;
         for (int i = 0; i < 8; ++i)
-            threads.emplace_back(stress_test, i, 1000);
+            threads.emplace_back(stress_test<AtomicRefCount>, i, 1000);
+        for (int i = 0; i < 8; ++i)
+            threads.emplace_back(stress_test<BiasedRefCount>, i, 1000);
         for (auto& t : threads)
             t.join();
+
+        cross_thread_test<AtomicRefCount>(200);
+        cross_thread_test<BiasedRefCount>(200);
         std::cout << "Stress test completed successfully.\n";
     }
 
+    std::cout << "\n=== Stress Testing Memory Reclamation ===\n";
+    {
+        stack_stress_test<EpochReclaimer>(8, 20000);
+        stack_stress_test<HazardPointerReclaimer>(8, 20000);
+        queue_stress_test<EpochReclaimer>(4, 4, 20000);
+        queue_stress_test<HazardPointerReclaimer>(4, 4, 20000);
+        atomic_ptr_stress_test<EpochReclaimer>(8, 5000);
+        atomic_ptr_stress_test<HazardPointerReclaimer>(8, 5000);
+
+        // All worker threads have exited: free whatever is still waiting
+        EpochReclaimer::quiesce();
+        HazardPointerReclaimer::quiesce();
+        std::cout << "Lock-free stack, queue and AtomicSharedPtr hold their invariants.\n";
+    }
+
     // Compare performance of custom vs standard smart pointers
     std::cout << "\n=== Benchmarking ===\n";
     benchmark("LockFreeSharedPtr", [](TestData* p) { return LockFreeSharedPtr<TestData>(p); });
+    benchmark("BiasedSharedPtr", [](TestData* p) { return BiasedSharedPtr<TestData>(p); });
     benchmark("std::shared_ptr", [](TestData* p) { return std::shared_ptr<TestData>(p); });
 
+    std::cout << "\n=== Copy Throughput Scaling ===\n";
+    scaling_benchmark<LockFreeSharedPtr<TestData>>("LockFreeSharedPtr");
+    scaling_benchmark<BiasedSharedPtr<TestData>>("BiasedSharedPtr");
+    scaling_benchmark<std::shared_ptr<TestData>>("std::shared_ptr");
+
+    std::cout << "\nLive objects after tests: " << TestData::live.load() << "\n";
     return 0;
 }
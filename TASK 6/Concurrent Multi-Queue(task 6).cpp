@@ -1,32 +1,287 @@
-
 ///---- Concurrent Multi-Queue Producer-Consumer with Work-Stealing ----///
 
 #include <iostream>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
 #include <queue>
 #include <vector>
 #include <functional>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 using Task = std::function<void()>;
 
-// Thread-safe queue with condition variable
+// ---- Parking primitives ----
+// Wait while `word` still holds `expected`; callers re-check, so spurious wakeups are fine
+inline void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#elif __cplusplus >= 202002L
+    word.wait(expected, std::memory_order_acquire);
+#else
+    (void)word; (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+inline void futex_wake(std::atomic<uint32_t>& word, int count) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#elif __cplusplus >= 202002L
+    if (count == 1) word.notify_one(); else word.notify_all();
+#else
+    (void)word; (void)count;
+#endif
+}
+
+// Tells the CPU we are spinning (saves power, frees the sibling hyperthread)
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Eventcount spanning all queues: lets idle workers sleep until work arrives anywhere.
+// Waiter:   key = prepare_wait(); re-check the queues; then wait(key) or cancel_wait().
+// Notifier: publish the task, then notify(). The epoch bump makes a wait() that
+// raced with the publish return at once, so no wakeup is ever lost.
+class EventCount {
+    std::atomic<uint32_t> epoch{ 0 };    // futex word
+    std::atomic<uint32_t> waiters{ 0 };  // threads between prepare_wait and wait/cancel_wait
+
+    void signal(int count) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // order the publish before reading waiters
+        if (waiters.load(std::memory_order_relaxed) == 0) return;  // fast path: nobody parked
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        futex_wake(epoch, count);
+    }
+
+public:
+    uint32_t prepare_wait() {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_seq_cst);
+    }
+
+    void cancel_wait() { waiters.fetch_sub(1, std::memory_order_seq_cst); }
+
+    void wait(uint32_t key) {
+        while (epoch.load(std::memory_order_acquire) == key)
+            futex_wait(epoch, key);
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void notify() { signal(1); }
+    void notify_all() { signal(INT_MAX); }
+};
+
+// Counts submitted-but-unfinished tasks; wait() returns exactly when it reaches zero.
+// A task that submits follow-up work does so before its own count_down, so the
+// count cannot touch zero while work is still outstanding.
+class CompletionLatch {
+    std::atomic<uint32_t> outstanding{ 0 };  // futex word
+
+public:
+    void add(uint32_t n = 1) { outstanding.fetch_add(n, std::memory_order_relaxed); }
+
+    void count_down() {
+        if (outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            futex_wake(outstanding, INT_MAX);
+    }
+
+    void wait() {
+        uint32_t n;
+        while ((n = outstanding.load(std::memory_order_acquire)) != 0)
+            futex_wait(outstanding, n);
+    }
+};
+
+// ---- Binary event tracing ----
+// Each thread appends 16-byte records to its own single-producer ring; a
+// background thread drains the rings, and the result is exported as Chrome
+// trace JSON (chrome://tracing or ui.perfetto.dev). Recording costs a clock
+// read and a few stores; when tracing is off it is a single relaxed load.
+enum class TraceEvent : uint8_t { Enqueue, Dequeue, Steal, RunBegin, RunEnd, Park, Unpark };
+
+struct TraceRecord {
+    uint64_t timestamp_ns;
+    uint32_t arg;  // queue index, victim index or task id, depending on the event
+    uint16_t tid;  // tracer-assigned thread number
+    TraceEvent type;
+};
+
+class Tracer {
+    struct ThreadBuffer {
+        static constexpr size_t capacity = 1 << 16;  // records (1 MB); must be a power of two
+        TraceRecord records[capacity];
+        alignas(64) std::atomic<uint64_t> head{ 0 };  // written by the owning thread
+        alignas(64) std::atomic<uint64_t> tail{ 0 };  // written by the drainer
+        std::atomic<uint64_t> dropped{ 0 };
+        uint16_t tid = 0;
+        ThreadBuffer* next = nullptr;
+    };
+
+    inline static std::atomic<bool> enabled{ false };
+    inline static std::atomic<ThreadBuffer*> buffers{ nullptr };  // never freed: the drainer may outlive a thread
+    inline static std::atomic<uint16_t> next_tid{ 0 };
+    inline static std::atomic<bool> draining{ false };
+    inline static std::thread drainer;
+    inline static std::mutex collected_mtx;
+    inline static std::vector<TraceRecord> collected;
+
+    static uint64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static ThreadBuffer* local() {
+        thread_local ThreadBuffer* buf = nullptr;
+        if (!buf) {
+            buf = new ThreadBuffer;
+            buf->tid = next_tid.fetch_add(1, std::memory_order_relaxed);
+            buf->next = buffers.load(std::memory_order_relaxed);
+            while (!buffers.compare_exchange_weak(buf->next, buf, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {}
+        }
+        return buf;
+    }
+
+    static void drain_once() {
+        std::lock_guard<std::mutex> lock(collected_mtx);
+        for (ThreadBuffer* b = buffers.load(std::memory_order_acquire); b; b = b->next) {
+            uint64_t tail = b->tail.load(std::memory_order_relaxed);
+            uint64_t head = b->head.load(std::memory_order_acquire);
+            for (; tail < head; ++tail)
+                collected.push_back(b->records[tail & (ThreadBuffer::capacity - 1)]);
+            b->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    static const char* name(TraceEvent type) {
+        switch (type) {
+        case TraceEvent::Enqueue: return "enqueue";
+        case TraceEvent::Dequeue: return "dequeue";
+        case TraceEvent::Steal: return "steal";
+        case TraceEvent::RunBegin: case TraceEvent::RunEnd: return "run";
+        case TraceEvent::Park: case TraceEvent::Unpark: return "idle";
+        }
+        return "?";
+    }
+
+public:
+    static void record(TraceEvent type, uint32_t arg = 0) {
+        if (!enabled.load(std::memory_order_relaxed)) return;
+        ThreadBuffer* b = local();
+        uint64_t head = b->head.load(std::memory_order_relaxed);
+        if (head - b->tail.load(std::memory_order_acquire) >= ThreadBuffer::capacity) {
+            b->dropped.fetch_add(1, std::memory_order_relaxed);  // drainer fell behind: drop, never block
+            return;
+        }
+        b->records[head & (ThreadBuffer::capacity - 1)] = { now_ns(), arg, b->tid, type };
+        b->head.store(head + 1, std::memory_order_release);
+    }
+
+    static void start() {
+        enabled.store(true, std::memory_order_relaxed);
+        draining.store(true, std::memory_order_relaxed);
+        drainer = std::thread([]() {
+            while (draining.load(std::memory_order_relaxed)) {
+                drain_once();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    static void stop() {
+        enabled.store(false, std::memory_order_relaxed);
+        draining.store(false, std::memory_order_relaxed);
+        if (drainer.joinable()) drainer.join();
+        drain_once();
+    }
+
+    static size_t event_count() {
+        std::lock_guard<std::mutex> lock(collected_mtx);
+        return collected.size();
+    }
+
+    static uint64_t dropped() {
+        uint64_t total = 0;
+        for (ThreadBuffer* b = buffers.load(std::memory_order_acquire); b; b = b->next)
+            total += b->dropped.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // Run and idle spans become B/E pairs; queue operations become instant events
+    static bool write_chrome_trace(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) return false;
+        std::lock_guard<std::mutex> lock(collected_mtx);
+        uint64_t origin = collected.empty() ? 0 : collected.front().timestamp_ns;
+        for (const auto& r : collected) origin = std::min(origin, r.timestamp_ns);
+
+        out << "{\"traceEvents\":[\n";
+        for (size_t i = 0; i < collected.size(); ++i) {
+            const TraceRecord& r = collected[i];
+            const char* phase = "i";
+            if (r.type == TraceEvent::RunBegin || r.type == TraceEvent::Park) phase = "B";
+            if (r.type == TraceEvent::RunEnd || r.type == TraceEvent::Unpark) phase = "E";
+            out << "{\"name\":\"" << name(r.type) << "\",\"ph\":\"" << phase << "\""
+                << (phase[0] == 'i' ? ",\"s\":\"t\"" : "")
+                << ",\"pid\":1,\"tid\":" << r.tid
+                << ",\"ts\":" << std::fixed << std::setprecision(3) << (r.timestamp_ns - origin) / 1000.0
+                << ",\"args\":{\"arg\":" << r.arg << "}}"
+                << (i + 1 < collected.size() ? ",\n" : "\n");
+        }
+        out << "]}\n";
+        return static_cast<bool>(out);
+    }
+};
+
+// Thread-safe queue guarded by a mutex. Idle workers park on the pool's
+// EventCount, not on the queue, so the queue itself never blocks.
 class TaskQueue {
     std::queue<Task> tasks;
     std::mutex mtx;
-    std::condition_variable cv;
 
 public:
-    // Producer pushes task into the queue and notifies a waiting consumer
     void push(Task task) {
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-            tasks.push(std::move(task));
-        }
-        cv.notify_one();
+        std::lock_guard<std::mutex> lock(mtx);
+        tasks.push(std::move(task));
+    }
+
+    // Any thread may push into a mutex-guarded queue
+    void inject(Task task) { push(std::move(task)); }
+
+    // Unbounded: enqueues all n under one lock acquisition
+    size_t try_push_bulk(Task* items, size_t n) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (size_t i = 0; i < n; ++i) tasks.push(std::move(items[i]));
+        return n;
     }
 
     // Consumer tries to pop a task (non-blocking, for stealing)
@@ -38,117 +293,906 @@ public:
         return true;
     }
 
-    // Consumer waits for a task (blocking)
-    bool wait_pop(Task& task, std::atomic<bool>& done) {
-        std::unique_lock<std::mutex> lock(mtx);
-        cv.wait(lock, [&]() { return !tasks.empty() || done; });
-        if (tasks.empty()) return false; // woke up due to `done`
-        task = std::move(tasks.front());
-        tasks.pop();
-        return true;
+    // Thieves and the owner share the same end of the queue
+    bool steal(Task& task) { return try_pop(task); }
+
+    // Steal-half: migrate half of the tasks under a single lock acquisition
+    size_t steal_batch(std::vector<Task>& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t n = (tasks.size() + 1) / 2;
+        for (size_t i = 0; i < n; ++i) {
+            out.push_back(std::move(tasks.front()));
+            tasks.pop();
+        }
+        return n;
     }
 
     bool empty() {
         std::lock_guard<std::mutex> lock(mtx);
         return tasks.empty();
     }
+};
+
+// Lock-free Chase-Lev work-stealing deque (Le et al., PPoPP 2013).
+// The owner pushes and pops at the bottom with plain loads/stores (a CAS is
+// only needed when racing thieves for the last task); thieves CAS from the
+// top, so steals never contend with the owner's fast path.
+class ChaseLevDeque {
+    // Circular buffer of task pointers; slots are atomic because a thief may
+    // read a slot the owner is about to reuse after wrap-around
+    struct Buffer {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+
+        explicit Buffer(int64_t cap) : capacity(cap), slots(new std::atomic<Task*>[cap]) {}
+
+        Task* get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, Task* t) { slots[i & (capacity - 1)].store(t, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<int64_t> top{0};     // thieves' end
+    alignas(64) std::atomic<int64_t> bottom{0};  // owner's end
+    std::atomic<Buffer*> buffer;
+
+    // Buffers replaced by growth stay alive until the deque is destroyed, since a
+    // thief may still be reading one; capacities double, so this at most doubles memory
+    std::vector<std::unique_ptr<Buffer>> retired;
+
+    // Tasks injected by non-owner threads; moved into the deque by the owner
+    std::mutex inbox_mtx;
+    std::vector<Task> inbox;
+    std::atomic<bool> has_inbox{false};
+
+    Buffer* grow(Buffer* old, int64_t b, int64_t t) {
+        Buffer* bigger = new Buffer(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i)
+            bigger->put(i, old->get(i));
+        retired.emplace_back(old);
+        buffer.store(bigger, std::memory_order_release);
+        return bigger;
+    }
 
-    void notify() {
-        cv.notify_one();
+    // Owner only: move injected tasks into the deque
+    bool drain_inbox() {
+        if (!has_inbox.load(std::memory_order_acquire)) return false;
+        std::vector<Task> batch;
+        {
+            std::lock_guard<std::mutex> lock(inbox_mtx);
+            batch.swap(inbox);
+            has_inbox.store(false, std::memory_order_relaxed);
+        }
+        for (auto& task : batch)
+            push(std::move(task));
+        return !batch.empty();
     }
-};
 
-// Worker thread that executes tasks from its own queue or steals from others
-class Worker {
-    int id;
-    std::vector<TaskQueue*>& queues;
-    TaskQueue* ownQueue;
-    std::atomic<bool>& done;
+    bool pop_bottom(Task& task) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {  // empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        Task* item = buf->get(b);
+        if (t == b) {  // last task: race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) return false;
+        }
+        task = std::move(*item);
+        delete item;
+        return true;
+    }
 
 public:
-    Worker(int id, std::vector<TaskQueue*>& qs, TaskQueue* own, std::atomic<bool>& done)
-        : id(id), queues(qs), ownQueue(own), done(done) {}
+    explicit ChaseLevDeque(int64_t initial_capacity = 64) : buffer(new Buffer(initial_capacity)) {}
 
-    void operator()() {
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    ~ChaseLevDeque() {
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        for (int64_t i = top.load(); i < bottom.load(); ++i)
+            delete buf->get(i);
+        delete buf;
+    }
+
+    // Owner thread only (or before the owner starts); other threads use inject()
+    void push(Task task) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        if (b - t > buf->capacity - 1)
+            buf = grow(buf, b, t);
+        buf->put(b, new Task(std::move(task)));
+        bottom.store(b + 1, std::memory_order_release);  // publishes the slot to thieves
+    }
+
+    // Owner only. The buffer grows, so all n are enqueued
+    size_t try_push_bulk(Task* items, size_t n) {
+        for (size_t i = 0; i < n; ++i) push(std::move(items[i]));
+        return n;
+    }
+
+    // Any thread: hand a task to this queue's owner
+    void inject(Task task) {
+        std::lock_guard<std::mutex> lock(inbox_mtx);
+        inbox.push_back(std::move(task));
+        has_inbox.store(true, std::memory_order_release);
+    }
+
+    // Owner pops the most recently pushed task (LIFO keeps caches warm)
+    bool try_pop(Task& task) {
+        return pop_bottom(task) || (drain_inbox() && pop_bottom(task));
+    }
+
+    // Thieves take the oldest task from the top
+    bool steal(Task& task) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t < b) {
+            Buffer* buf = buffer.load(std::memory_order_acquire);
+            Task* item = buf->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed))
+                return false;  // lost the race to another thief or the owner
+            task = std::move(*item);
+            delete item;
+            return true;
+        }
+
+        // Deque empty: take directly from the inbox if the owner hasn't yet
+        if (has_inbox.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> lock(inbox_mtx, std::try_to_lock);
+            if (lock.owns_lock() && !inbox.empty()) {
+                task = std::move(inbox.back());
+                inbox.pop_back();
+                has_inbox.store(!inbox.empty(), std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Steal-half: take up to half of the visible tasks, one CAS each. A single
+    // CAS moving top by several slots would race the owner's CAS-free pops.
+    size_t steal_batch(std::vector<Task>& out) {
+        int64_t visible = bottom.load(std::memory_order_acquire) - top.load(std::memory_order_acquire);
+        int64_t want = std::max<int64_t>(1, (visible + 1) / 2);
         Task task;
-        while (!done) {
-            // Try to pop task from own queue (blocking)
-            if (ownQueue->wait_pop(task, done)) {
-                std::cout << "Thread " << id << " executing task\n";
-                task();
+        size_t got = 0;
+        while (static_cast<int64_t>(got) < want && steal(task)) {
+            out.push_back(std::move(task));
+            ++got;
+        }
+        return got;
+    }
+
+    bool empty() {
+        return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire) &&
+               !has_inbox.load(std::memory_order_acquire);
+    }
+};
+
+// What a producer does when the bounded queue is full
+enum class Backpressure {
+    Block,   // spin briefly, then park until a consumer frees a slot
+    Spin,    // busy-wait until a slot frees up
+    Reject   // give up immediately; push() returns false
+};
+
+// Bounded multi-producer/multi-consumer ring (Vyukov). Each slot carries a
+// sequence number that says whose turn it is, so producers and consumers
+// only contend on their own position counter and never take a lock.
+// Memory stays fixed at `capacity` slots however far producers run ahead.
+template <typename T = Task>
+class BoundedMPMCQueue {
+    struct alignas(64) Cell {
+        std::atomic<size_t> seq;  // == pos: free for producer pos; == pos + 1: holds item pos
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    const size_t mask;
+    const Backpressure policy;
+    alignas(64) std::atomic<size_t> enqueue_pos{ 0 };
+    alignas(64) std::atomic<size_t> dequeue_pos{ 0 };
+    EventCount not_full;  // producers parked under Backpressure::Block
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Parked producers are woken only once the ring is at most half full, so a
+    // full ring does not ping-pong one wakeup per freed slot. No wakeup is lost:
+    // a producer parks only after seeing the ring full, so the pops that bring
+    // it down to half all happen after the producer has announced itself.
+    void slot_freed() {
+        if (policy != Backpressure::Block) return;
+        size_t head = dequeue_pos.load(std::memory_order_relaxed);
+        if (enqueue_pos.load(std::memory_order_relaxed) - head <= capacity() / 2)
+            not_full.notify_all();  // a fence and a load when nobody is parked
+    }
+
+    template <typename TryFn>
+    bool apply_backpressure(TryFn try_once) {
+        if (try_once()) return true;
+        if (policy == Backpressure::Reject) return false;
+        while (true) {
+            for (int i = 0; i < 64; ++i) {
+                cpu_relax();
+                if (try_once()) return true;
+            }
+            if (policy == Backpressure::Spin) continue;
+            uint32_t key = not_full.prepare_wait();
+            if (try_once()) {
+                not_full.cancel_wait();
+                return true;
+            }
+            not_full.wait(key);
+        }
+    }
+
+public:
+    explicit BoundedMPMCQueue(size_t capacity = 4096, Backpressure policy = Backpressure::Block)
+        : cells(new Cell[round_up_pow2(capacity)]), mask(round_up_pow2(capacity) - 1), policy(policy) {
+        for (size_t i = 0; i <= mask; ++i)
+            cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Non-blocking; `value` is only moved from on success
+    bool try_push(T&& value) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;  // full: the slot still holds last lap's item
             } else {
-                // Try to steal task from other queues (non-blocking)
-                bool stolen = false;
-                for (auto q : queues) {
-                    if (q != ownQueue && q->try_pop(task)) {
-                        std::cout << "Thread " << id << " stole a task\n";
-                        task();
-                        stolen = true;
-                        break;
-                    }
-                }
-                // If nothing stolen, optional brief sleep (not necessary here due to blocking wait)
-                if (!stolen)
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Applies the queue's backpressure policy; false only under Backpressure::Reject
+    bool push(T value) {
+        return apply_backpressure([&]() { return try_push(std::move(value)); });
+    }
+
+    // Any thread may push into an MPMC queue
+    void inject(T value) { push(std::move(value)); }
+
+    bool try_pop(T& out) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;  // empty (or the producer of this slot has not finished)
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
             }
         }
+        out = std::move(cell->data);
+        cell->seq.store(pos + mask + 1, std::memory_order_release);  // free for the next lap
+        slot_freed();
+        return true;
+    }
+
+    // Producers and consumers are symmetric, so a thief just pops
+    bool steal(T& out) { return try_pop(out); }
 
-        // Final draining in case tasks were pushed before shutdown
-        while (ownQueue->try_pop(task)) {
-            task();
+    // Claims up to n slots with a single CAS; returns how many items were enqueued
+    size_t try_push_bulk(T* items, size_t n) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        size_t k;
+        while (true) {
+            size_t used = std::min(pos - std::min(pos, dequeue_pos.load(std::memory_order_acquire)), capacity());
+            k = std::min(n, capacity() - used);
+            if (k == 0) return 0;
+            if (enqueue_pos.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                break;
         }
+
+        for (size_t i = 0; i < k; ++i) {
+            Cell& cell = cells[(pos + i) & mask];
+            // The slot's previous item has been claimed; its consumer may still be copying it out
+            while (cell.seq.load(std::memory_order_acquire) != pos + i)
+                cpu_relax();
+            cell.data = std::move(items[i]);
+            cell.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return k;
+    }
+
+    // Enqueues all n items, applying the backpressure policy between partial batches
+    size_t push_bulk(T* items, size_t n) {
+        size_t done = 0;
+        while (done < n) {
+            bool ok = apply_backpressure([&]() {
+                size_t k = try_push_bulk(items + done, n - done);
+                done += k;
+                return k > 0;
+            });
+            if (!ok) break;
+        }
+        return done;
+    }
+
+    // Claims up to max published items with a single CAS
+    size_t pop_bulk(T* out, size_t max) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        size_t k;
+        while (true) {
+            // Only claim items whose producers have finished writing
+            k = 0;
+            while (k < max && cells[(pos + k) & mask].seq.load(std::memory_order_acquire) == pos + k + 1)
+                ++k;
+            if (k == 0) return 0;
+            if (dequeue_pos.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                break;
+        }
+
+        for (size_t i = 0; i < k; ++i) {
+            Cell& cell = cells[(pos + i) & mask];
+            out[i] = std::move(cell.data);
+            cell.seq.store(pos + i + mask + 1, std::memory_order_release);
+        }
+        slot_freed();
+        return k;
+    }
+
+    // Steal-half: one CAS claims half of the visible items
+    size_t steal_batch(std::vector<T>& out) {
+        size_t head = dequeue_pos.load(std::memory_order_acquire);
+        size_t visible = enqueue_pos.load(std::memory_order_acquire) - head;
+        size_t want = std::max<size_t>(1, (std::min(visible, capacity()) + 1) / 2);
+        size_t base = out.size();
+        out.resize(base + want);
+        size_t got = pop_bulk(out.data() + base, want);
+        out.resize(base + got);
+        return got;
+    }
+
+    bool empty() {
+        return enqueue_pos.load(std::memory_order_acquire) == dequeue_pos.load(std::memory_order_acquire);
     }
 };
 
-int main() {
-    const int num_threads = 2;
-    std::vector<std::thread> threads;
-    std::vector<TaskQueue*> queues;
-    std::vector<TaskQueue> queue_objects(num_threads);
+// ---- CPU topology and stealing policies ----
+
+// Which L3 cache and NUMA node each logical CPU belongs to, read from
+// /sys/devices/system/cpu; everything maps to 0 where that is unavailable
+struct CpuTopology {
+    std::vector<int> l3_of_cpu;
+    std::vector<int> numa_of_cpu;
+
+    static CpuTopology detect() {
+        CpuTopology topo;
+        int cpus = std::max(1u, std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            topo.l3_of_cpu.push_back(read_int(base + "/cache/index3/id", 0));
+            topo.numa_of_cpu.push_back(numa_node(base));
+        }
+        return topo;
+    }
+
+    int cpus() const { return static_cast<int>(l3_of_cpu.size()); }
+
+private:
+    static int read_int(const std::string& path, int fallback) {
+        std::ifstream in(path);
+        int value;
+        return (in >> value) ? value : fallback;
+    }
+
+    // A CPU's directory holds a `nodeN` link naming its NUMA node
+    static int numa_node(const std::string& cpu_dir) {
+#if defined(__linux__)
+        if (DIR* dir = opendir(cpu_dir.c_str())) {
+            int node = 0;
+            while (dirent* entry = readdir(dir)) {
+                if (std::strncmp(entry->d_name, "node", 4) == 0 && std::isdigit(entry->d_name[4])) {
+                    node = std::atoi(entry->d_name + 4);
+                    break;
+                }
+            }
+            closedir(dir);
+            return node;
+        }
+#endif
+        (void)cpu_dir;
+        return 0;
+    }
+};
+
+// Restrict the calling thread to one CPU (no-op where unsupported)
+inline void pin_to_cpu(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// How an idle worker picks victims and how much it takes from them
+struct StealPolicy {
+    enum class Victim {
+        Sequential,  // scan queues in index order (every thief hits queue 0 first)
+        Random,      // start the scan at a random queue
+        Local        // same L3 first, then same NUMA node, then the rest; random within each tier
+    };
+
+    Victim victim = Victim::Sequential;
+    bool steal_half = false;   // take half of the victim's tasks instead of one
+    bool pin_threads = false;  // pin worker i to CPU i % cpus
+
+    static StealPolicy sequential() { return {}; }
+    static StealPolicy random() { return { Victim::Random, false, false }; }
+    static StealPolicy random_half() { return { Victim::Random, true, false }; }
+    static StealPolicy topology_aware(bool pin = true) { return { Victim::Local, true, pin }; }
+};
+
+// Per-worker counters, read by the benchmark once the pool is idle
+struct alignas(64) WorkerStats {
+    std::atomic<uint64_t> tasks_run{ 0 };
+    std::atomic<uint64_t> steals{ 0 };        // successful steal operations
+    std::atomic<uint64_t> stolen_tasks{ 0 };  // tasks migrated by those steals
+
+    // Single writer (the worker), so a plain load + store is enough
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+// State shared by every worker in a pool
+template <typename Queue>
+struct PoolState {
+    std::vector<Queue*> queues;
     std::atomic<bool> done{ false };
+    EventCount idle;
+    CompletionLatch pending;
+    StealPolicy policy;
+    CpuTopology topology;
+};
+
+// Worker thread that executes tasks from its own queue or steals from others.
+// When nothing is found it spins briefly, then parks on the shared EventCount
+// until a task is submitted to any queue (or shutdown is signalled).
+template <typename Queue = TaskQueue>
+class Worker {
+    int id;
+    PoolState<Queue>& pool;
+    Queue* ownQueue;
+    WorkerStats& stats;
+    std::vector<std::vector<int>> victim_tiers;  // victims grouped by preference
+    uint64_t rng_state;
+    std::vector<Task> batch;
 
-    // Initialize queues
-    for (int i = 0; i < num_threads; ++i)
-        queues.push_back(&queue_objects[i]);
+    static constexpr int spin_rounds = 64;
 
-    // Main thread acts as producer
-    for (int i = 0; i < 5; ++i) {
-        queues[i % num_threads]->push([i]() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            std::cout << "  → Task " << i << " executed by thread " << std::this_thread::get_id() << "\n";
-        });
+    int cpu() const { return id % pool.topology.cpus(); }
+
+    uint64_t next_random() {  // xorshift64: cheap and private to this worker
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        return rng_state;
+    }
+
+    void build_victim_tiers() {
+        const int n = static_cast<int>(pool.queues.size());
+        const StealPolicy::Victim mode = pool.policy.victim;
+        if (mode != StealPolicy::Victim::Local) {
+            victim_tiers.emplace_back();
+            for (int v = 0; v < n; ++v)
+                if (v != id) victim_tiers[0].push_back(v);
+            return;
+        }
+        const CpuTopology& topo = pool.topology;
+        std::vector<int> same_l3, same_node, remote;
+        for (int v = 0; v < n; ++v) {
+            if (v == id) continue;
+            int vcpu = v % topo.cpus();
+            if (topo.l3_of_cpu[vcpu] == topo.l3_of_cpu[cpu()] && topo.numa_of_cpu[vcpu] == topo.numa_of_cpu[cpu()])
+                same_l3.push_back(v);
+            else if (topo.numa_of_cpu[vcpu] == topo.numa_of_cpu[cpu()])
+                same_node.push_back(v);
+            else
+                remote.push_back(v);
+        }
+        for (auto* tier : { &same_l3, &same_node, &remote })
+            if (!tier->empty()) victim_tiers.push_back(std::move(*tier));
+    }
+
+    bool steal_from(int victim, Task& task) {
+        if (!pool.policy.steal_half) {
+            if (!pool.queues[victim]->steal(task)) return false;
+            Tracer::record(TraceEvent::Steal, victim);
+            WorkerStats::bump(stats.steals);
+            WorkerStats::bump(stats.stolen_tasks);
+            return true;
+        }
+        batch.clear();
+        if (pool.queues[victim]->steal_batch(batch) == 0) return false;
+        Tracer::record(TraceEvent::Steal, victim);
+        WorkerStats::bump(stats.steals);
+        WorkerStats::bump(stats.stolen_tasks, batch.size());
+        task = std::move(batch[0]);
+        // A blocking push could park us on our own full bounded queue, where
+        // only we would ever make room; what does not fit is run right here
+        size_t queued = batch.size() > 1 ? ownQueue->try_push_bulk(batch.data() + 1, batch.size() - 1) : 0;
+        if (queued > 0)
+            pool.idle.notify();  // the extra tasks can now be stolen from us
+        for (size_t i = 1 + queued; i < batch.size(); ++i)
+            run(batch[i]);
+        return true;
     }
 
-    // Start worker threads (consumers)
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back(Worker(i, queues, queues[i], done));
+    bool find_task(Task& task) {
+        if (ownQueue->try_pop(task)) {
+            Tracer::record(TraceEvent::Dequeue, id);
+            return true;
+        }
+        // Try to steal task from other queues (non-blocking)
+        bool randomized = pool.policy.victim != StealPolicy::Victim::Sequential;
+        for (const auto& tier : victim_tiers) {
+            size_t start = randomized ? next_random() % tier.size() : 0;
+            for (size_t k = 0; k < tier.size(); ++k) {
+                if (steal_from(tier[(start + k) % tier.size()], task))
+                    return true;
+            }
+        }
+        return false;
     }
 
-    // Wait until all queues are empty
-    while (true) {
-        bool all_empty = true;
-        for (auto q : queues) {
-            if (!q->empty()) {
-                all_empty = false;
+    void run(Task& task) {
+        Tracer::record(TraceEvent::RunBegin, id);
+        task();
+        task = nullptr;  // release captures before the task counts as finished
+        Tracer::record(TraceEvent::RunEnd, id);
+        WorkerStats::bump(stats.tasks_run);
+        pool.pending.count_down();
+    }
+
+public:
+    Worker(int id, PoolState<Queue>& pool, WorkerStats& stats)
+        : id(id), pool(pool), ownQueue(pool.queues[id]), stats(stats),
+          rng_state(0x9E3779B97F4A7C15ull * (id + 1)) {
+        build_victim_tiers();
+    }
+
+    void operator()() {
+        if (pool.policy.pin_threads)
+            pin_to_cpu(cpu());
+
+        Task task;
+        while (true) {
+            if (find_task(task)) {
+                run(task);
+                continue;
+            }
+
+            // Spin briefly first: short gaps between tasks are common
+            bool found = false;
+            for (int i = 0; i < spin_rounds && !found; ++i) {
+                cpu_relax();
+                found = find_task(task);
+            }
+            if (found) {
+                run(task);
+                continue;
+            }
+
+            // Announce the intent to sleep, then re-check so a racing submit is never missed
+            uint32_t key = pool.idle.prepare_wait();
+            if (find_task(task)) {
+                pool.idle.cancel_wait();
+                run(task);
+                continue;
+            }
+            if (pool.done.load()) {
+                pool.idle.cancel_wait();
                 break;
             }
+            Tracer::record(TraceEvent::Park, id);
+            pool.idle.wait(key);
+            Tracer::record(TraceEvent::Unpark, id);
+        }
+    }
+};
+
+// Owns the queues and workers plus the shared parking and completion state
+template <typename Queue>
+class WorkerPool {
+    std::vector<std::unique_ptr<Queue>> queue_objects;
+    PoolState<Queue> state;
+    std::unique_ptr<WorkerStats[]> stats;
+    std::vector<std::thread> threads;
+
+public:
+    explicit WorkerPool(int num_threads, StealPolicy policy = StealPolicy::sequential())
+        : stats(new WorkerStats[num_threads]) {
+        state.policy = policy;
+        state.topology = CpuTopology::detect();
+
+        // Initialize queues
+        for (int i = 0; i < num_threads; ++i) {
+            queue_objects.emplace_back(new Queue);
+            state.queues.push_back(queue_objects[i].get());
         }
-        if (all_empty) break;
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Start worker threads (consumers)
+        for (int i = 0; i < num_threads; ++i)
+            threads.emplace_back(Worker<Queue>(i, state, stats[i]));
+    }
+
+    // Any thread (including a running task) may submit to any queue
+    void submit(int queue_index, Task task) {
+        state.pending.add();
+        size_t target = queue_index % state.queues.size();
+        Tracer::record(TraceEvent::Enqueue, static_cast<uint32_t>(target));
+        state.queues[target]->inject(std::move(task));
+        state.idle.notify();
+    }
+
+    // Blocks until every submitted task (and anything they submitted) has run
+    void wait_all() { state.pending.wait(); }
+
+    // Totals across workers: { tasks run, steal operations, stolen tasks }
+    std::array<uint64_t, 3> totals() const {
+        std::array<uint64_t, 3> sum{};
+        for (size_t i = 0; i < threads.size(); ++i) {
+            sum[0] += stats[i].tasks_run.load(std::memory_order_relaxed);
+            sum[1] += stats[i].steals.load(std::memory_order_relaxed);
+            sum[2] += stats[i].stolen_tasks.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    ~WorkerPool() {
+        wait_all();
+
+        // Signal threads to stop and wake any parked ones
+        state.done = true;
+        state.idle.notify_all();
+
+        // Join all threads
+        for (auto& t : threads) {
+            if (t.joinable()) t.join();
+        }
+    }
+};
+
+// Runs the producer/consumer demo with the given queue type behind each worker
+template <typename Queue>
+void run_demo(const std::string& label) {
+    const int num_threads = 2;
+    std::cout << "=== " << label << " ===\n";
+    {
+        WorkerPool<Queue> pool(num_threads);
+
+        // Main thread acts as producer
+        for (int i = 0; i < 5; ++i) {
+            pool.submit(i, [i]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                std::cout << "  → Task " << i << " executed by thread " << std::this_thread::get_id() << "\n";
+            });
+        }
+    }  // Pool waits for exactly the submitted tasks, then shuts down
+    std::cout << "All tasks completed.\n\n";
+}
+
+// Measures how long a parked worker takes to pick up a newly submitted task
+template <typename Queue>
+void measure_wakeup_latency(const std::string& label) {
+    const int rounds = 200;
+    WorkerPool<Queue> pool(2);
+    std::atomic<int64_t> total_ns{ 0 };
+
+    for (int r = 0; r < rounds; ++r) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));  // let the workers park
+        auto submitted = std::chrono::steady_clock::now();
+        pool.submit(r, [&total_ns, submitted]() {
+            auto started = std::chrono::steady_clock::now();
+            total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(started - submitted).count();
+        });
+        pool.wait_all();
     }
+    std::cout << label << " average wake-up latency: " << total_ns / rounds / 1000.0 << " us\n";
+}
+
+// Imbalanced load: one producer floods queue 0 while a second trickles into queue 1,
+// so everything the other workers do is stolen work
+template <typename Queue>
+void benchmark_steal_policy(const std::string& label, StealPolicy policy) {
+    const int num_threads = 4;
+    const int heavy_tasks = 100000;
+    const int light_tasks = 1000;
+    std::atomic<uint64_t> sink{ 0 };
+
+    auto work = [&sink]() {
+        uint64_t x = 0;
+        for (int i = 0; i < 200; ++i) x = x * 6364136223846793005ull + i;
+        sink.fetch_add(x & 1, std::memory_order_relaxed);
+    };
+
+    WorkerPool<Queue> pool(num_threads, policy);
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread heavy([&]() { for (int i = 0; i < heavy_tasks; ++i) pool.submit(0, work); });
+    std::thread light([&]() { for (int i = 0; i < light_tasks; ++i) pool.submit(1, work); });
+    heavy.join();
+    light.join();
+    pool.wait_all();
+
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+    auto totals = pool.totals();
+    std::cout << std::left << std::setw(26) << label << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << totals[0] / dur.count() / 1e6
+              << std::setw(12) << totals[1] << std::setw(14) << totals[2] << "\n";
+}
+
+template <typename Queue>
+void compare_steal_policies(const std::string& label) {
+    std::cout << "\n=== Steal policies (" << label << ", imbalanced producers) ===\n";
+    std::cout << std::left << std::setw(26) << "Policy" << std::right
+              << std::setw(12) << "M tasks/s" << std::setw(12) << "Steals" << std::setw(14) << "Stolen tasks" << "\n";
+    benchmark_steal_policy<Queue>("sequential", StealPolicy::sequential());
+    benchmark_steal_policy<Queue>("random", StealPolicy::random());
+    benchmark_steal_policy<Queue>("random + steal-half", StealPolicy::random_half());
+    benchmark_steal_policy<Queue>("topology + half + pinned", StealPolicy::topology_aware());
+}
+
+// Raw queue throughput: producers push trivial tasks, consumers pop and run them
+template <typename Queue>
+double measure_queue_throughput(int producers, int consumers, int per_producer, size_t bulk = 1) {
+    Queue queue;
+    const int64_t total = static_cast<int64_t>(producers) * per_producer;
+    std::atomic<int64_t> consumed{ 0 };
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&]() {
+            if constexpr (std::is_same_v<Queue, BoundedMPMCQueue<Task>>) {
+                std::vector<Task> batch(bulk);
+                for (int i = 0; i < per_producer; i += static_cast<int>(bulk)) {
+                    size_t n = std::min<size_t>(bulk, per_producer - i);
+                    for (size_t k = 0; k < n; ++k) batch[k] = []() {};
+                    queue.push_bulk(batch.data(), n);
+                }
+            } else {
+                for (int i = 0; i < per_producer; ++i) queue.push([]() {});
+            }
+        });
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&]() {
+            std::vector<Task> batch(bulk);
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                size_t n = 0;
+                if constexpr (std::is_same_v<Queue, BoundedMPMCQueue<Task>>)
+                    n = bulk > 1 ? queue.pop_bulk(batch.data(), bulk) : queue.try_pop(batch[0]);
+                else
+                    n = queue.try_pop(batch[0]);
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (size_t k = 0; k < n; ++k) batch[k]();
+                consumed.fetch_add(static_cast<int64_t>(n), std::memory_order_relaxed);
+            }
+        });
+    for (auto& t : threads)
+        t.join();
 
-    // Signal threads to stop
-    done = true;
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+    return total / dur.count() / 1e6;
+}
 
-    // Wake up any waiting threads
-    for (auto& q : queues)
-        q->notify();
+void compare_queue_throughput() {
+    const int total_items = 400000;
+    const int configs[][2] = { {1, 1}, {2, 2}, {4, 4}, {1, 4}, {4, 1} };
 
-    // Join all threads
-    for (auto& t : threads) {
-        if (t.joinable()) t.join();
+    std::cout << "\n=== Queue throughput (M ops/s) ===\n";
+    std::cout << std::left << std::setw(10) << "P x C" << std::right << std::setw(12) << "TaskQueue"
+              << std::setw(12) << "Ring" << std::setw(16) << "Ring bulk 32" << "\n";
+    for (auto& cfg : configs) {
+        int per_producer = total_items / cfg[0];
+        std::cout << std::left << std::setw(10) << (std::to_string(cfg[0]) + " x " + std::to_string(cfg[1]))
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << measure_queue_throughput<TaskQueue>(cfg[0], cfg[1], per_producer)
+                  << std::setw(12) << measure_queue_throughput<BoundedMPMCQueue<Task>>(cfg[0], cfg[1], per_producer)
+                  << std::setw(16) << measure_queue_throughput<BoundedMPMCQueue<Task>>(cfg[0], cfg[1], per_producer, 32)
+                  << "\n";
     }
+}
+
+// With Backpressure::Reject a full queue turns pushes away instead of growing
+void demo_backpressure() {
+    BoundedMPMCQueue<int> queue(8, Backpressure::Reject);
+    int accepted = 0, rejected = 0;
+    for (int i = 0; i < 20; ++i)
+        (queue.push(i) ? accepted : rejected)++;
+    std::cout << "\nBounded ring (capacity " << queue.capacity() << ", reject policy): "
+              << accepted << " accepted, " << rejected << " rejected\n";
+}
+
+// Runs the same imbalanced workload with tracing off and on, then exports the
+// traced run for chrome://tracing or ui.perfetto.dev
+void trace_demo() {
+    const int tasks = 20000;
+    auto work = []() {
+        volatile uint64_t x = 0;
+        for (int i = 0; i < 500; ++i) x = x + i;
+    };
+    auto run_once = [&]() {
+        auto start = std::chrono::steady_clock::now();
+        {
+            WorkerPool<ChaseLevDeque> pool(4, StealPolicy::random_half());
+            for (int i = 0; i < tasks; ++i) pool.submit(0, work);
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double untraced = run_once();
+    Tracer::start();
+    double traced = run_once();
+    Tracer::stop();
+
+    const std::string path = "task6_trace.json";
+    bool written = Tracer::write_chrome_trace(path);
+    std::cout << "\n=== Tracing ===\n" << std::fixed << std::setprecision(3)
+              << "Untraced run: " << untraced * 1e3 << " ms, traced run: " << traced * 1e3 << " ms\n"
+              << "Recorded " << Tracer::event_count() << " events (" << Tracer::dropped() << " dropped)"
+              << (written ? ", written to " + path : ", could not write " + path) << "\n";
+}
+
+int main() {
+    run_demo<TaskQueue>("Mutex TaskQueue");
+    run_demo<ChaseLevDeque>("Lock-free ChaseLevDeque");
+    run_demo<BoundedMPMCQueue<Task>>("Bounded MPMC ring");
+
+    measure_wakeup_latency<TaskQueue>("Mutex TaskQueue");
+    measure_wakeup_latency<ChaseLevDeque>("Lock-free ChaseLevDeque");
+    measure_wakeup_latency<BoundedMPMCQueue<Task>>("Bounded MPMC ring");
+
+    compare_steal_policies<TaskQueue>("Mutex TaskQueue");
+    compare_steal_policies<ChaseLevDeque>("Lock-free ChaseLevDeque");
+    compare_steal_policies<BoundedMPMCQueue<Task>>("Bounded MPMC ring");
 
-    std::cout << "All tasks completed.\n";
+    demo_backpressure();
+    compare_queue_throughput();
+    trace_demo();
     return 0;
 }
@@ -6,9 +6,127 @@
 #include <vector>
 #include <cmath>
 #include <stdexcept>
+#include <complex>
+#include <string>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <array>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
-const double EPSILON = 1e-6; // Small tolerance for floating-point comparisons
+constexpr double EPSILON = 1e-6; // Small tolerance for floating-point comparisons
+
+// Multiplication algorithms; Auto picks by size (see Polynomial::multiply)
+enum class MulMethod { Auto, Schoolbook, Karatsuba, FFT };
+const size_t KARATSUBA_THRESHOLD = 96;   // below this, schoolbook wins
+const size_t FFT_THRESHOLD = 2048;       // from here up, FFT wins
+const double FFT_MAX_DYNAMIC_RANGE = 1e6; // wider coefficient ranges lose small terms in FFT rounding
+const size_t ESTRIN_MIN_DEGREE = 8;       // batch evaluation switches from Horner to Estrin here
+
+// Lane types for batch evaluation: one x per lane, so every point runs its own
+// independent chain. The widest set the compiler targets is picked as SimdLanes.
+struct ScalarLanes {
+    using V = double;
+    struct Slot { V v; };  // lets vector<> hold registers with their alignment
+    static constexpr size_t width = 1;
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V set1(double c) { return c; }
+    static V fmadd(V a, V b, V c) { return a * b + c; }
+    static V mul(V a, V b) { return a * b; }
+};
+
+#if defined(__AVX512F__)
+struct Avx512Lanes {
+    using V = __m512d;
+    struct Slot { V v; };  // lets vector<> hold registers with their alignment
+    static constexpr size_t width = 8;
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V set1(double c) { return _mm512_set1_pd(c); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+};
+using SimdLanes = Avx512Lanes;
+#elif defined(__AVX2__) && defined(__FMA__)
+struct Avx2Lanes {
+    using V = __m256d;
+    struct Slot { V v; };  // lets vector<> hold registers with their alignment
+    static constexpr size_t width = 4;
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double c) { return _mm256_set1_pd(c); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+};
+using SimdLanes = Avx2Lanes;
+#else
+using SimdLanes = ScalarLanes;
+#endif
+
+// Result of the simultaneous all-roots solver
+struct RootResult {
+    vector<complex<double>> roots;  // every root, complex ones included (repeated roots appear repeatedly)
+    vector<double> error_bounds;    // a true root lies within error_bounds[i] of roots[i] (a whole cluster, for overlapping disks)
+    int iterations = 0;
+    bool converged = false;
+    string method;                  // "Aberth-Ehrlich" or "Durand-Kerner" (fallback)
+};
+
+// Root finders shared by Polynomial and StaticPolynomial. P provides
+// evaluate(x) and evaluate(x, deriv); constexpr when P's evaluate is.
+template <class T>
+constexpr T absValue(T x) { return x < 0 ? -x : x; }
+
+template <class P, class T>
+constexpr T newtonRaphsonOf(const P& p, T guess, int max_iter) {
+    T x = guess;
+    for (int i = 0; i < max_iter; ++i) {
+        T dfx{};                        // f'(x)
+        T fx = p.evaluate(x, dfx);      // f(x)
+        if (absValue(dfx) < EPSILON)
+            throw runtime_error("Derivative too small. Try different guess.");
+        T x_new = x - fx / dfx;         // Newton's formula
+        if (absValue(x_new - x) < EPSILON)
+            return x_new;
+        x = x_new;
+    }
+    throw runtime_error("Did not converge.");
+}
+
+template <class P, class T>
+constexpr T bisectionOf(const P& p, T a, T b, int max_iter) {
+    T fa = p.evaluate(a);
+    T fb = p.evaluate(b);
+    if (fa * fb > 0)
+        throw runtime_error("f(a) and f(b) must have opposite signs.");
+
+    for (int i = 0; i < max_iter; ++i) {
+        T mid = (a + b) / 2;
+        T fmid = p.evaluate(mid);
+        if (absValue(fmid) < EPSILON || absValue(b - a) < EPSILON)
+            return mid;
+
+        if (fa * fmid < 0) {
+            b = mid; fb = fmid;
+        } else {
+            a = mid; fa = fmid;
+        }
+    }
+    throw runtime_error("Did not converge.");
+}
 
 // Class to represent a polynomial
 class Polynomial {
@@ -37,6 +155,48 @@ public:
         return result;
     }
 
+    // Value and derivative in one Horner pass, without building derivative()
+    double evaluate(double x, double& deriv) const {
+        double result = 0;
+        deriv = 0;
+        for (int i = coeffs.size() - 1; i >= 0; --i) {
+            deriv = deriv * x + result;
+            result = result * x + coeffs[i];
+        }
+        return result;
+    }
+
+    // Batch evaluation: out[i] = p(xs[i]), and dout[i] = p'(xs[i]) when dout is
+    // given. Vectorised across points; from ESTRIN_MIN_DEGREE up, Estrin's scheme
+    // cuts each point's dependency chain from n to log2(n) multiply-adds.
+    void evaluate(const double* xs, double* out, size_t n, double* dout = nullptr) const {
+        if (coeffs.empty()) {
+            fill(out, out + n, 0.0);
+            if (dout) fill(dout, dout + n, 0.0);
+            return;
+        }
+        vector<double> dc;
+        if (dout) {
+            for (size_t i = 1; i < coeffs.size(); ++i) dc.push_back(i * coeffs[i]);
+            if (dc.empty()) dc.push_back(0.0);
+        }
+        size_t done = evaluateKernel<SimdLanes>(xs, out, dout, n, dc);
+        evaluateKernel<ScalarLanes>(xs + done, out + done, dout ? dout + done : nullptr, n - done, dc);
+    }
+
+#if __cplusplus >= 202002L
+    void evaluate(span<const double> xs, span<double> out) const {
+        if (out.size() < xs.size()) throw invalid_argument("Output span is shorter than input.");
+        evaluate(xs.data(), out.data(), xs.size());
+    }
+
+    void evaluate(span<const double> xs, span<double> out, span<double> dout) const {
+        if (out.size() < xs.size() || dout.size() < xs.size())
+            throw invalid_argument("Output span is shorter than input.");
+        evaluate(xs.data(), out.data(), xs.size(), dout.data());
+    }
+#endif
+
     // Return the derivative polynomial
     Polynomial derivative() const {
         vector<double> deriv;
@@ -63,53 +223,831 @@ public:
 
     // Multiplication of two polynomials
     Polynomial operator*(const Polynomial& other) const {
-        vector<double> result(coeffs.size() + other.coeffs.size() - 1, 0);
-        for (int i = 0; i < coeffs.size(); ++i)
-            for (int j = 0; j < other.coeffs.size(); ++j)
-                result[i + j] += coeffs[i] * other.coeffs[j];
+        return multiply(other);
+    }
+
+    // What multiply(other, Auto) runs: schoolbook for short factors, Karatsuba
+    // for mid sizes and FFT for long ones. FFT rounding error is about
+    // eps * log2(N) * |a|_2 * |b|_2 on every coefficient, so operands whose
+    // coefficients span more than FFT_MAX_DYNAMIC_RANGE stay on Karatsuba to
+    // keep their small terms accurate.
+    MulMethod autoMethod(const Polynomial& other) const {
+        const vector<double>& a = coeffs;
+        const vector<double>& b = other.coeffs;
+        size_t shorter = min(a.size(), b.size());
+        if (shorter < KARATSUBA_THRESHOLD)
+            return MulMethod::Schoolbook;
+        if (shorter >= FFT_THRESHOLD && dynamicRange(a) <= FFT_MAX_DYNAMIC_RANGE &&
+            dynamicRange(b) <= FFT_MAX_DYNAMIC_RANGE)
+            return MulMethod::FFT;
+        return MulMethod::Karatsuba;
+    }
+
+    Polynomial multiply(const Polynomial& other, MulMethod method = MulMethod::Auto) const {
+        const vector<double>& a = coeffs;
+        const vector<double>& b = other.coeffs;
+        if (a.empty() || b.empty()) return Polynomial({});
+        if (method == MulMethod::Auto) method = autoMethod(other);
+
+        vector<double> result(a.size() + b.size() - 1, 0);
+        switch (method) {
+        case MulMethod::FFT:
+            fftMultiply(a, b, result);
+            break;
+        case MulMethod::Karatsuba:
+            karatsubaUnbalanced(a, b, result);
+            break;
+        default:
+            schoolbook(a.data(), a.size(), b.data(), b.size(), result.data());
+        }
         return Polynomial(result);
     }
 
+    const vector<double>& coefficients() const { return coeffs; }
+
+    // Degree ignoring zero leading coefficients (-1 for the zero polynomial)
+    int degree() const {
+        int d = static_cast<int>(coeffs.size()) - 1;
+        while (d >= 0 && coeffs[d] == 0) --d;
+        return d;
+    }
+
+    // Find all roots at once with Aberth-Ehrlich iteration (cubic convergence for
+    // simple roots). Falls back to Durand-Kerner if Aberth stalls. Throws only
+    // for the zero polynomial: otherwise check `converged`, and use
+    // error_bounds as inclusion radii (up to the rounding in evaluating p).
+    RootResult allRoots(int max_iter = 500) const {
+        RootResult result;
+        int n = degree();
+        if (n < 0)
+            throw runtime_error("The zero polynomial has no isolated roots.");
+
+        // Roots at zero come straight from trailing zero coefficients
+        int zeros = 0;
+        while (zeros < n && coeffs[zeros] == 0) ++zeros;
+        vector<double> a(coeffs.begin() + zeros, coeffs.begin() + n + 1);
+        vector<double> rev(a.rbegin(), a.rend());
+        for (int i = 0; i < zeros; ++i) {
+            result.roots.push_back(0.0);
+            result.error_bounds.push_back(0.0);
+        }
+
+        int m = n - zeros;
+        result.method = "Aberth-Ehrlich";
+        if (m == 0) {
+            result.converged = true;
+            return result;
+        }
+        if (m == 1) {
+            result.roots.push_back(-a[0] / a[1]);
+            result.error_bounds.push_back(0.0);
+            result.converged = true;
+            return result;
+        }
+
+        vector<complex<double>> z = initialEstimates(a);
+        vector<bool> done(m, false);
+        int remaining = m;
+
+        // Aberth: z_i -= N_i / (1 - N_i * sum_j 1/(z_i - z_j)), with N_i = p(z_i)/p'(z_i)
+        for (int it = 0; it < max_iter && remaining > 0; ++it, ++result.iterations) {
+            for (int i = 0; i < m; ++i) {
+                if (done[i]) continue;
+                complex<double> ratio;
+                if (newtonRatio(a, rev, z[i], ratio)) {  // p(z_i) is at rounding-error level
+                    done[i] = true;
+                    --remaining;
+                    continue;
+                }
+                complex<double> sum = 0.0;
+                for (int j = 0; j < m; ++j)
+                    if (j != i) sum += 1.0 / (z[i] - z[j]);
+                complex<double> step = ratio / (1.0 - ratio * sum);
+                z[i] -= step;
+                if (abs(step) <= 4 * numeric_limits<double>::epsilon() * abs(z[i])) {
+                    done[i] = true;
+                    --remaining;
+                }
+            }
+        }
+
+        // Fallback: Weierstrass / Durand-Kerner from where Aberth stopped
+        if (remaining > 0) {
+            result.method = "Durand-Kerner";
+            for (int it = 0; it < max_iter && remaining > 0; ++it, ++result.iterations) {
+                remaining = 0;
+                for (int i = 0; i < m; ++i) {
+                    complex<double> log_denominator = log(complex<double>(a[m]));
+                    for (int j = 0; j < m; ++j)
+                        if (j != i) log_denominator += log(z[i] - z[j]);
+                    complex<double> step = exp(logValue(a, rev, z[i]) - log_denominator);
+                    z[i] -= step;
+                    if (abs(step) > 1e3 * numeric_limits<double>::epsilon() * max(1.0, abs(z[i])))
+                        ++remaining;
+                }
+            }
+        }
+
+        result.converged = remaining == 0;
+        vector<double> radius(m);
+        for (int i = 0; i < m; ++i) radius[i] = inclusionRadius(a, rev, z, i);
+        mergeOverlappingDisks(z, radius);
+        for (int i = 0; i < m; ++i) {
+            result.roots.push_back(z[i]);
+            result.error_bounds.push_back(radius[i]);
+        }
+        return result;
+    }
+
+    // All distinct real roots, ascending, with no guess or bracket needed.
+    // 1. Isolation: p is scaled by a power of two so its roots lie in (-1, 1),
+    //    and Descartes' rule of signs on the Moebius transform of p to each
+    //    interval bounds its root count (Vincent-Collins-Akritas bisection).
+    //    The transform runs in double-double with a rigorous error bound, so a
+    //    coefficient only has a sign when it is certain; a count that is not
+    //    certainly 0 or 1 splits the interval at a point where p is certainly
+    //    non-zero. Every reported simple root is therefore inside a verified
+    //    bracket.
+    // 2. Refinement: each bracket is polished by safeguarded Newton-bisection
+    //    until its width is below rel_tol * |x|. Brackets are shared out over
+    //    num_threads; the refinement loop itself never allocates.
+    // Roots closer together than rel_tol * |x| (a multiple root, or a cluster
+    // at rounding level) come back once, as the middle of their interval.
+    vector<double> realRoots(double rel_tol = 1e-14, unsigned num_threads = 1) const {
+        int n = degree();
+        if (n < 0)
+            throw runtime_error("The zero polynomial has no isolated roots.");
+
+        // Each trailing zero coefficient is a root at exactly 0
+        int low = 0;
+        while (coeffs[low] == 0) ++low;
+        vector<double> roots;
+        if (low > 0) roots.push_back(0.0);
+        if (low == n) return roots;
+
+        // Fujiwara bound, rounded up to 2^shift: the roots of a(x) = p(2^shift x) lie in (-1, 1)
+        const int m = n - low;
+        double bound = 0;
+        for (int k = 1; k <= m; ++k)
+            bound = max(bound, pow(fabs(coeffs[n - k] / coeffs[n]) / (k == m ? 2 : 1), 1.0 / k));
+        const int shift = ilogb(2.02 * bound) + 1;
+        // a_k = p_(low+k) 2^(shift k - top), exact unless a term falls 2^1022 below the largest
+        int top = numeric_limits<int>::min();
+        for (int k = 0; k <= m; ++k)
+            if (coeffs[low + k] != 0) top = max(top, ilogb(coeffs[low + k]) + shift * k);
+        vector<double> a(m + 1);
+        for (int k = 0; k <= m; ++k) a[k] = ldexp(coeffs[low + k], shift * k - top);
+
+        vector<pair<double, double>> brackets, clusters;
+        isolateRoots(a, rel_tol, brackets, clusters);
+
+        // Parallel refinement into preallocated slots
+        Polynomial q(a);
+        size_t first = roots.size();
+        roots.resize(first + brackets.size());
+        if (num_threads == 0) num_threads = max(1u, thread::hardware_concurrency());
+        num_threads = static_cast<unsigned>(min<size_t>(num_threads, max<size_t>(1, brackets.size())));
+        atomic<size_t> next{0};
+        auto refine_all = [&]() {
+            for (size_t i = next++; i < brackets.size(); i = next++)
+                roots[first + i] = ldexp(q.refineRoot(brackets[i].first, brackets[i].second, rel_tol), shift);
+        };
+        vector<thread> workers;
+        for (unsigned t = 1; t < num_threads; ++t) workers.emplace_back(refine_all);
+        refine_all();
+        for (auto& w : workers) w.join();
+
+        for (const auto& c : clusters) roots.push_back(ldexp(c.first + (c.second - c.first) / 2, shift));
+        sort(roots.begin(), roots.end());
+        return roots;
+    }
+
     // Find root using Newton-Raphson method
     double newtonRaphson(double guess, int max_iter = 1000) const {
-        Polynomial deriv = derivative();
-        double x = guess;
-        for (int i = 0; i < max_iter; ++i) {
-            double fx = evaluate(x);        // f(x)
-            double dfx = deriv.evaluate(x); // f'(x)
-            if (fabs(dfx) < EPSILON)
-                throw runtime_error("Derivative too small. Try different guess.");
-            double x_new = x - fx / dfx;    // Newton's formula
-            if (fabs(x_new - x) < EPSILON)
-                return x_new;
-            x = x_new;
-        }
-        throw runtime_error("Did not converge.");
+        return newtonRaphsonOf(*this, guess, max_iter);
     }
 
     // Find root using Bisection method
     double bisection(double a, double b, int max_iter = 1000) const {
-        double fa = evaluate(a);
-        double fb = evaluate(b);
-        if (fa * fb > 0)
-            throw runtime_error("f(a) and f(b) must have opposite signs.");
-
-        for (int i = 0; i < max_iter; ++i) {
-            double mid = (a + b) / 2;
-            double fmid = evaluate(mid);
-            if (fabs(fmid) < EPSILON || fabs(b - a) < EPSILON)
-                return mid;
-
-            if (fa * fmid < 0) {
-                b = mid; fb = fmid;
-            } else {
-                a = mid; fa = fmid;
+        return bisectionOf(*this, a, b, max_iter);
+    }
+
+private:
+    // ---- Real root isolation and refinement ----
+
+    // Double-double numbers for the verified sign tests: hi + lo with |lo| <=
+    // ulp(hi) / 2. Each operation below errs by at most 4u^2 (u = 2^-53) times
+    // the magnitude of its operands, so a computation run alongside on
+    // absolute values bounds the error of the whole.
+    struct DoubleDouble { double hi, lo; };
+
+    static DoubleDouble twoSum(double a, double b) {
+        double s = a + b, t = s - a;
+        return {s, (a - (s - t)) + (b - t)};
+    }
+
+    static DoubleDouble add(DoubleDouble a, DoubleDouble b) {
+        DoubleDouble s = twoSum(a.hi, b.hi);
+        return twoSum(s.hi, s.lo + (a.lo + b.lo));
+    }
+
+    static DoubleDouble mul(DoubleDouble a, double b) {
+        double p = a.hi * b;
+        return twoSum(p, fma(a.hi, b, -p) + a.lo * b);
+    }
+
+    // Error of a double-double result of n + 1 chained steps whose absolute-value
+    // twin is size; the second term covers low parts lost to underflow
+    static double roundingBound(size_t n, double size) {
+        return 64.0 * (n + 1) * (ldexp(size, -106) + numeric_limits<double>::denorm_min());
+    }
+
+    // Value of a at x with a certain sign, or 0 when rounding could hide its sign
+    static double certainValue(const vector<double>& a, double x) {
+        DoubleDouble v{0, 0};
+        double size = 0;
+        for (size_t k = a.size(); k-- > 0;) {
+            v = add(mul(v, x), {a[k], 0});
+            size = size * fabs(x) + fabs(a[k]);
+        }
+        return fabs(v.hi) > roundingBound(a.size(), size) ? v.hi : 0.0;
+    }
+
+    // Fewest and most sign changes the coefficients of
+    // (x + 1)^n a((hi x + lo) / (x + 1)) can have given the rounding of their
+    // computation. The exact count is between them, and by Descartes' rule
+    // it bounds the number of roots of a in (lo, hi) and has their parity.
+    // The transform is a homogeneous Horner scheme in L = hi x + lo, R = x + 1:
+    // S_0 = a_n, S_j = S_(j-1) L + a_(n-j) R^j.
+    static void signChanges(const vector<double>& a, double lo, double hi, int& fewest, int& most) {
+        const size_t n = a.size() - 1;
+        vector<DoubleDouble> s(n + 1, {0, 0}), binom(n + 1, {0, 0});
+        vector<double> size(n + 1, 0.0);
+        s[0] = {a[n], 0};
+        size[0] = fabs(a[n]);
+        binom[0] = {1, 0};
+        for (size_t j = 1; j <= n; ++j) {
+            for (size_t i = j; i > 0; --i) binom[i] = add(binom[i], binom[i - 1]);  // row j of Pascal's triangle
+            const double c = a[n - j];
+            for (size_t i = j; i-- > 0;) {  // S_j[i + 1] gets S_(j-1)[i] hi, S_j[i] gets S_(j-1)[i] lo
+                s[i + 1] = add(s[i + 1], mul(s[i], hi));
+                size[i + 1] += size[i] * fabs(hi);
+                s[i] = mul(s[i], lo);
+                size[i] *= fabs(lo);
+            }
+            for (size_t i = 0; i <= j; ++i) {
+                s[i] = add(s[i], mul(binom[i], c));
+                size[i] += binom[i].hi * fabs(c);
+            }
+        }
+
+        // Smallest and largest count so far, per sign of the last certain-or-chosen coefficient
+        const int none = numeric_limits<int>::max() / 2;
+        int lo_count[2] = {none, none}, hi_count[2] = {-none, -none};
+        bool started = false;
+        for (size_t i = 0; i <= n; ++i) {
+            if (size[i] == 0) continue;  // an exact zero
+            const bool sure = fabs(s[i].hi) > roundingBound(n, size[i]);
+            int next_lo[2] = {none, none}, next_hi[2] = {-none, -none};
+            for (int sign = 0; sign < 2; ++sign) {
+                if (sure && sign != (s[i].hi < 0)) continue;
+                if (!started) {
+                    next_lo[sign] = next_hi[sign] = 0;
+                    continue;
+                }
+                next_lo[sign] = min(lo_count[sign], lo_count[1 - sign] + 1);
+                next_hi[sign] = max(hi_count[sign], hi_count[1 - sign] + 1);
+            }
+            started = true;
+            copy(next_lo, next_lo + 2, lo_count);
+            copy(next_hi, next_hi + 2, hi_count);
+        }
+        fewest = min(lo_count[0], lo_count[1]);
+        most = max(hi_count[0], hi_count[1]);
+    }
+
+    // Splits (-1, 1) until each interval certainly holds no root or exactly one
+    // (a bracket). Intervals narrower than rel_tol * |x| that still may hold
+    // several roots are clusters; one is kept if it surely holds a root (an odd
+    // count or a sign change of a across it) or its count is surely non-zero,
+    // which puts a root, possibly complex, within the interval's radius of its
+    // middle. Touching clusters are one cluster. a(0) != 0 and a(+-1) != 0.
+    static void isolateRoots(const vector<double>& a, double rel_tol,
+                             vector<pair<double, double>>& brackets, vector<pair<double, double>>& clusters) {
+        vector<pair<double, double>> work{{-1.0, 1.0}};
+        while (!work.empty()) {
+            auto [lo, hi] = work.back();
+            work.pop_back();
+            int fewest, most;
+            signChanges(a, lo, hi, fewest, most);
+            if (most == 0) continue;
+            if (fewest == 1 && most == 1) {
+                brackets.push_back({lo, hi});
+                continue;
+            }
+
+            // Split near the middle, at a point where a certainly does not vanish
+            const double width = hi - lo;
+            double mid = lo;
+            if (width > rel_tol * max(fabs(lo), fabs(hi)))
+                for (int k = 0; k <= 16; ++k) {
+                    double x = lo + width / 2 + (k % 2 ? 1 : -1) * ((k + 1) / 2) * (width / 64);
+                    if (x > lo && x < hi && certainValue(a, x) != 0) {
+                        mid = x;
+                        break;
+                    }
+                }
+            if (mid != lo) {
+                work.push_back({mid, hi});
+                work.push_back({lo, mid});
+                continue;
+            }
+
+            double at_lo = certainValue(a, lo), at_hi = certainValue(a, hi);
+            bool crosses = at_lo != 0 && at_hi != 0 && (at_lo < 0) != (at_hi < 0);
+            if (!crosses && fewest == 0) continue;
+            if (!clusters.empty() && clusters.back().second == lo)
+                clusters.back().second = hi;
+            else
+                clusters.push_back({lo, hi});
+        }
+    }
+
+    // Value and derivative of p with an error bound on the value: the value is
+    // accumulated in double-double, the derivative in plain doubles.
+    double evaluate(double x, double& deriv, double& error) const {
+        DoubleDouble v{0, 0};
+        double size = 0;
+        deriv = 0;
+        for (size_t k = coeffs.size(); k-- > 0;) {
+            deriv = deriv * x + v.hi;
+            v = add(mul(v, x), {coeffs[k], 0});
+            size = size * fabs(x) + fabs(coeffs[k]);
+        }
+        error = roundingBound(coeffs.size(), size);
+        return v.hi;
+    }
+
+    // Safeguarded Newton-bisection on a bracket holding one simple root. A Newton
+    // step is taken only when it stays inside the bracket and at least halves the
+    // previous step; otherwise the bracket is bisected. Stops when the bracket or
+    // step is below rel_tol * |x|, when p(x) is within its rounding bound of 0,
+    // or when no double lies strictly between the ends.
+    double refineRoot(double lo, double hi, double rel_tol) const {
+        double dummy, error;
+        if (evaluate(lo, dummy, error) > 0) swap(lo, hi);  // now p(lo) < 0 < p(hi)
+
+        double x = lo + (hi - lo) / 2, step_old = fabs(hi - lo), step = step_old;
+        for (int it = 0; it < 2200; ++it) {  // bisection alone can cross the whole double range
+            double df, f = evaluate(x, df, error);
+            if (fabs(f) <= error) return x;  // as close as p's sign can tell
+            if (f < 0) lo = x;
+            else hi = x;
+
+            double newton = df != 0 ? x - f / df : x;
+            bool use_newton = df != 0 && (newton - lo) * (newton - hi) < 0 && fabs(2 * f) <= fabs(step_old * df);
+            step_old = step;
+            double x_new = use_newton ? newton : lo + (hi - lo) / 2;
+            step = fabs(x_new - x);
+            x = x_new;
+
+            double tol = rel_tol * fabs(x) + numeric_limits<double>::denorm_min();
+            if (step <= tol || fabs(hi - lo) <= tol) return x;
+            double mid = lo + (hi - lo) / 2;
+            if (mid == lo || mid == hi) return x;  // bracket is two adjacent doubles
+        }
+        return x;
+    }
+
+    // ---- Batch evaluation kernels ----
+
+    // Processes whole vectors of L::width points and returns how many were done
+    template <class L>
+    size_t evaluateKernel(const double* xs, double* out, double* dout, size_t n,
+                          const vector<double>& dc) const {
+        using V = typename L::V;
+        const size_t len = coeffs.size();
+        // Scalar code already overlaps neighbouring points out of order, so plain Horner is faster there
+        const bool estrin = L::width > 1 && len > ESTRIN_MIN_DEGREE;
+        vector<typename L::Slot> pows, tmp;  // x^(2^k) and Estrin partial sums, reused across points
+        if (estrin) {
+            size_t levels = 1;
+            while ((size_t(1) << levels) < len) ++levels;
+            pows.resize(levels);
+            tmp.resize((len + 1) / 2);
+        }
+
+        size_t i = 0;
+        for (; i + L::width <= n; i += L::width) {
+            V x = L::load(xs + i);
+            if (!estrin) {
+                V p = L::set1(coeffs.back()), dp = L::set1(0.0);
+                if (dout) {
+                    for (size_t k = len - 1; k-- > 0;) {
+                        dp = L::fmadd(dp, x, p);
+                        p = L::fmadd(p, x, L::set1(coeffs[k]));
+                    }
+                    L::store(dout + i, dp);
+                } else {
+                    for (size_t k = len - 1; k-- > 0;)
+                        p = L::fmadd(p, x, L::set1(coeffs[k]));
+                }
+                L::store(out + i, p);
+                continue;
             }
+            pows[0].v = x;
+            for (size_t k = 1; k < pows.size(); ++k) pows[k].v = L::mul(pows[k - 1].v, pows[k - 1].v);
+            L::store(out + i, estrinSum<L>(coeffs.data(), len, pows.data(), tmp.data()));
+            if (dout) L::store(dout + i, estrinSum<L>(dc.data(), dc.size(), pows.data(), tmp.data()));
         }
-        throw runtime_error("Did not converge.");
+        return i;
+    }
+
+    // Estrin: pair terms as c[2i] + c[2i+1] x, then pair those with x^2, then x^4...
+    // The powers are shared between the value and derivative passes.
+    template <class L>
+    static typename L::V estrinSum(const double* c, size_t len, const typename L::Slot* pows,
+                                   typename L::Slot* tmp) {
+        size_t m = 0;
+        for (size_t k = 0; k + 1 < len; k += 2)
+            tmp[m++].v = L::fmadd(L::set1(c[k + 1]), pows[0].v, L::set1(c[k]));
+        if (len % 2) tmp[m++].v = L::set1(c[len - 1]);
+        for (size_t level = 1; m > 1; ++level) {
+            size_t next = 0;
+            for (size_t k = 0; k + 1 < m; k += 2)
+                tmp[next++].v = L::fmadd(tmp[k + 1].v, pows[level].v, tmp[k].v);
+            if (m % 2) tmp[next++] = tmp[m - 1];
+            m = next;
+        }
+        return tmp[0].v;
+    }
+
+    // ---- Multiplication kernels ----
+
+    // out[i + j] += a[i] * b[j]
+    static void schoolbook(const double* a, size_t n, const double* b, size_t m, double* out) {
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < m; ++j)
+                out[i + j] += a[i] * b[j];
+    }
+
+    // out[0 .. 2n-2] += a * b for two length-n operands.
+    // Split a = a0 + x^h a1, b = b0 + x^h b1, then
+    // a*b = z0 + x^h ((a0+a1)(b0+b1) - z0 - z2) + x^2h z2, three half-size products
+    static void karatsuba(const double* a, const double* b, size_t n, double* out) {
+        if (n < KARATSUBA_THRESHOLD) {
+            schoolbook(a, n, b, n, out);
+            return;
+        }
+        size_t h = n / 2, hi = n - h;  // hi >= h
+        vector<double> z0(2 * h - 1, 0), z2(2 * hi - 1, 0), z1(2 * hi - 1, 0);
+        vector<double> sa(a + h, a + n), sb(b + h, b + n);
+        for (size_t i = 0; i < h; ++i) {
+            sa[i] += a[i];
+            sb[i] += b[i];
+        }
+        karatsuba(a, b, h, z0.data());
+        karatsuba(a + h, b + h, hi, z2.data());
+        karatsuba(sa.data(), sb.data(), hi, z1.data());
+
+        for (size_t i = 0; i < z0.size(); ++i) z1[i] -= z0[i];
+        for (size_t i = 0; i < z2.size(); ++i) z1[i] -= z2[i];
+        for (size_t i = 0; i < z0.size(); ++i) out[i] += z0[i];
+        for (size_t i = 0; i < z1.size(); ++i) out[h + i] += z1[i];
+        for (size_t i = 0; i < z2.size(); ++i) out[2 * h + i] += z2[i];
+    }
+
+    // Cuts the longer operand into blocks the size of the shorter one, so each
+    // block product is a balanced Karatsuba
+    static void karatsubaUnbalanced(const vector<double>& a, const vector<double>& b, vector<double>& out) {
+        const vector<double>& lng = a.size() >= b.size() ? a : b;
+        const vector<double>& sht = a.size() >= b.size() ? b : a;
+        size_t m = sht.size();
+        vector<double> block(m), part(2 * m - 1);
+        for (size_t start = 0; start < lng.size(); start += m) {
+            size_t len = min(m, lng.size() - start);
+            fill(block.begin(), block.end(), 0.0);
+            copy(lng.begin() + start, lng.begin() + start + len, block.begin());
+            fill(part.begin(), part.end(), 0.0);
+            karatsuba(block.data(), sht.data(), m, part.data());
+            for (size_t i = 0; i < part.size() && start + i < out.size(); ++i)
+                out[start + i] += part[i];
+        }
+    }
+
+    // In-place iterative radix-2 FFT. Twiddles come from polar() per index
+    // rather than repeated multiplication, keeping their error at one ulp.
+    static void fft(vector<complex<double>>& x, bool inverse) {
+        const size_t n = x.size();
+        for (size_t i = 1, j = 0; i < n; ++i) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) swap(x[i], x[j]);
+        }
+        const double sign = inverse ? 1.0 : -1.0;
+        vector<complex<double>> w(n / 2);
+        for (size_t k = 0; k < n / 2; ++k)
+            w[k] = polar(1.0, sign * 2 * acos(-1.0) * k / n);
+        for (size_t len = 2; len <= n; len <<= 1) {
+            size_t stride = n / len;
+            for (size_t i = 0; i < n; i += len)
+                for (size_t k = 0; k < len / 2; ++k) {
+                    complex<double> u = x[i + k], v = x[i + k + len / 2] * w[k * stride];
+                    x[i + k] = u + v;
+                    x[i + k + len / 2] = u - v;
+                }
+        }
+    }
+
+    // Real convolution with a single forward complex FFT: pack z = a + i b,
+    // recover A_k = (Z_k + conj Z_{N-k}) / 2 and B_k = (Z_k - conj Z_{N-k}) / 2i,
+    // multiply, and invert. Operands are scaled by powers of two to unit max
+    // first, which is exact and keeps the rounding error relative.
+    static void fftMultiply(const vector<double>& a, const vector<double>& b, vector<double>& out) {
+        size_t n = 1;
+        while (n < out.size()) n <<= 1;
+        int ea = 0, eb = 0;
+        frexp(maxAbs(a), &ea);
+        frexp(maxAbs(b), &eb);
+
+        vector<complex<double>> z(n, 0.0);
+        for (size_t i = 0; i < a.size(); ++i) z[i].real(ldexp(a[i], -ea));
+        for (size_t i = 0; i < b.size(); ++i) z[i].imag(ldexp(b[i], -eb));
+        fft(z, false);
+
+        vector<complex<double>> c(n);
+        for (size_t k = 0; k < n; ++k) {
+            complex<double> zk = z[k], zr = conj(z[(n - k) & (n - 1)]);
+            complex<double> ak = (zk + zr) * 0.5;
+            complex<double> bk = (zk - zr) * complex<double>(0, -0.5);
+            c[k] = ak * bk;
+        }
+        fft(c, true);
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = ldexp(c[i].real() / n, ea + eb);
+    }
+
+    static double maxAbs(const vector<double>& v) {
+        double m = 0;
+        for (double x : v) m = max(m, fabs(x));
+        return m;
+    }
+
+    // Largest over smallest nonzero |coefficient|
+    static double dynamicRange(const vector<double>& v) {
+        double lo = numeric_limits<double>::infinity(), hi = 0;
+        for (double x : v)
+            if (x != 0) {
+                lo = min(lo, fabs(x));
+                hi = max(hi, fabs(x));
+            }
+        return hi == 0 ? 1.0 : hi / lo;
+    }
+
+    // ---- Root finding helpers ----
+
+    // Horner in complex arithmetic; also returns the derivative
+    static void hornerComplex(const vector<double>& a, complex<double> x,
+                              complex<double>& p, complex<double>& dp) {
+        p = a.back();
+        dp = 0.0;
+        for (int i = static_cast<int>(a.size()) - 2; i >= 0; --i) {
+            dp = dp * x + p;
+            p = p * x + a[i];
+        }
+    }
+
+    // Sum of |a_i| |x|^i: scales the rounding error of evaluating at x
+    static double absHorner(const vector<double>& a, double r) {
+        double s = 0;
+        for (int i = static_cast<int>(a.size()) - 1; i >= 0; --i)
+            s = s * r + fabs(a[i]);
+        return s;
+    }
+
+    // Computes p(x)/p'(x) without overflow: for |x| > 1 the reversed polynomial
+    // q(y) = y^n p(1/y) is evaluated at y = 1/x, using p/p' = x q / (n q - y q').
+    // Returns true when p(x) is already at the level of its rounding error.
+    static bool newtonRatio(const vector<double>& a, const vector<double>& rev,
+                            complex<double> x, complex<double>& ratio) {
+        const int n = static_cast<int>(a.size()) - 1;
+        const double tol = 4 * n * numeric_limits<double>::epsilon();
+        complex<double> p, dp;
+        if (abs(x) <= 1) {
+            hornerComplex(a, x, p, dp);
+            if (abs(p) <= tol * absHorner(a, abs(x))) return true;
+            ratio = p / dp;
+        } else {
+            complex<double> y = 1.0 / x;
+            hornerComplex(rev, y, p, dp);
+            if (abs(p) <= tol * absHorner(rev, abs(y))) return true;
+            ratio = x * p / (double(n) * p - y * dp);
+        }
+        return false;
+    }
+
+    // Complex logarithm of p(x), safe for high degrees and large |x|
+    static complex<double> logValue(const vector<double>& a, const vector<double>& rev, complex<double> x) {
+        const int n = static_cast<int>(a.size()) - 1;
+        complex<double> p, dp;
+        if (abs(x) <= 1) {
+            hornerComplex(a, x, p, dp);
+            return log(p);
+        }
+        hornerComplex(rev, 1.0 / x, p, dp);
+        return double(n) * log(x) + log(p);
+    }
+
+    // Gerschgorin-type inclusion radius n |p(z_i)| / |a_n prod_{j!=i} (z_i - z_j)|,
+    // with |p(z_i)| raised by its rounding bound. The union of these disks
+    // contains every root; see mergeOverlappingDisks for single disks.
+    static double inclusionRadius(const vector<double>& a, const vector<double>& rev,
+                                  const vector<complex<double>>& z, int i) {
+        const int n = static_cast<int>(z.size());
+        const double x = abs(z[i]);
+        double log_size = x <= 1 ? log(absHorner(a, x)) : n * log(x) + log(absHorner(rev, 1 / x));
+        double log_err = log(4.0 * (n + 1) * numeric_limits<double>::epsilon()) + log_size;
+        double log_p = logValue(a, rev, z[i]).real(), top = max(log_p, log_err);
+        double log_r = log(double(n)) + top + log(exp(log_p - top) + exp(log_err - top)) - log(fabs(a[n]));
+        for (int j = 0; j < n; ++j)
+            if (j != i) log_r -= log(abs(z[i] - z[j]));
+        return exp(log_r);
+    }
+
+    // Only the union of the inclusion disks is guaranteed: a connected group of
+    // k overlapping disks holds exactly k roots, but not one per disk (near a
+    // multiple root they often all sit off the root). Every disk in a group is
+    // widened to cover the whole group, so each radius holds for its own root.
+    static void mergeOverlappingDisks(const vector<complex<double>>& z, vector<double>& r) {
+        const int n = static_cast<int>(z.size());
+        vector<int> group(n, -1), members;
+        vector<double> widened;
+        for (int s = 0; s < n; ++s) {
+            if (group[s] >= 0) continue;
+            group[s] = s;
+            members.assign(1, s);
+            for (size_t k = 0; k < members.size(); ++k)  // flood fill over overlapping disks
+                for (int j = 0; j < n; ++j)
+                    if (group[j] < 0 && abs(z[members[k]] - z[j]) <= r[members[k]] + r[j]) {
+                        group[j] = s;
+                        members.push_back(j);
+                    }
+            if (members.size() == 1) continue;
+            widened.assign(members.size(), 0.0);
+            for (size_t k = 0; k < members.size(); ++k)
+                for (int j : members) widened[k] = max(widened[k], abs(z[members[k]] - z[j]) + r[j]);
+            for (size_t k = 0; k < members.size(); ++k) r[members[k]] = widened[k];
+        }
+    }
+
+    // Initial guesses from the Newton polygon (upper convex hull of (i, log|a_i|)):
+    // each hull edge from i to k contributes k - i points on a circle whose radius
+    // matches the size of that group of roots
+    static vector<complex<double>> initialEstimates(const vector<double>& a) {
+        const int n = static_cast<int>(a.size()) - 1;
+        vector<int> hull;
+        for (int i = 0; i <= n; ++i) {
+            if (a[i] == 0) continue;
+            while (hull.size() >= 2) {
+                int i1 = hull[hull.size() - 2], i2 = hull.back();
+                double cross = (i2 - i1) * (log(fabs(a[i])) - log(fabs(a[i1]))) -
+                               (i - i1) * (log(fabs(a[i2])) - log(fabs(a[i1])));
+                if (cross >= 0) hull.pop_back();  // i2 lies on or below the chord
+                else break;
+            }
+            hull.push_back(i);
+        }
+
+        vector<complex<double>> z;
+        const double two_pi = 2 * acos(-1.0), sigma = 0.7;  // sigma breaks symmetry with real roots
+        for (size_t h = 0; h + 1 < hull.size(); ++h) {
+            int i = hull[h], k = hull[h + 1];
+            double radius = exp((log(fabs(a[i])) - log(fabs(a[k]))) / (k - i));
+            for (int j = 0; j < k - i; ++j)
+                z.push_back(polar(radius, two_pi * j / (k - i) + two_pi * i / n + sigma));
+        }
+        return z;
+    }
+};
+
+// Fixed-degree polynomial with its coefficients in a std::array: no heap
+// allocation, and everything is constexpr. Evaluation is unrolled at compile
+// time, derivative() has type StaticPolynomial<T, Degree - 1>, and arithmetic
+// results carry their degree in the type. Converts to and from Polynomial.
+template <class T, size_t Degree>
+class StaticPolynomial {
+    array<T, Degree + 1> coeffs{}; // coeffs[i] stores the coefficient of x^i
+
+public:
+    static constexpr size_t degree = Degree;
+
+    constexpr StaticPolynomial() = default;
+    constexpr StaticPolynomial(const array<T, Degree + 1>& c) : coeffs(c) {}
+
+    // StaticPolynomial p(-6.0, 11.0, -6.0, 1.0) deduces StaticPolynomial<double, 3>
+    template <class... Ts, class = enable_if_t<sizeof...(Ts) == Degree + 1 && conjunction_v<is_arithmetic<Ts>...>>>
+    constexpr StaticPolynomial(Ts... c) : coeffs{static_cast<T>(c)...} {}
+
+    // From a dynamic polynomial; throws if it does not fit in Degree
+    explicit StaticPolynomial(const Polynomial& p) {
+        if (p.degree() > static_cast<int>(Degree))
+            throw invalid_argument("Polynomial degree exceeds StaticPolynomial degree.");
+        for (int i = 0; i <= p.degree(); ++i) coeffs[i] = static_cast<T>(p.coefficients()[i]);
+    }
+
+    operator Polynomial() const { return Polynomial(vector<double>(coeffs.begin(), coeffs.end())); }
+
+    constexpr T operator[](size_t i) const { return coeffs[i]; }
+    constexpr const array<T, Degree + 1>& coefficients() const { return coeffs; }
+
+    // Horner, unrolled through a fold expression
+    constexpr T evaluate(T x) const { return horner(x, make_index_sequence<Degree + 1>{}); }
+
+    // Value and derivative in one pass
+    constexpr T evaluate(T x, T& deriv) const {
+        T result = coeffs[Degree];
+        deriv = T(0);
+        for (size_t i = Degree; i-- > 0;) {
+            deriv = deriv * x + result;
+            result = result * x + coeffs[i];
+        }
+        return result;
+    }
+
+    // Derivative of a constant stays a (zero) constant
+    constexpr auto derivative() const {
+        constexpr size_t D = Degree == 0 ? 0 : Degree - 1;
+        array<T, D + 1> c{};
+        for (size_t i = 1; i <= Degree; ++i) c[i - 1] = static_cast<T>(i) * coeffs[i];
+        return StaticPolynomial<T, D>(c);
+    }
+
+    template <size_t D2>
+    constexpr StaticPolynomial<T, (Degree > D2 ? Degree : D2)> operator+(const StaticPolynomial<T, D2>& o) const {
+        array<T, (Degree > D2 ? Degree : D2) + 1> c{};
+        for (size_t i = 0; i <= Degree; ++i) c[i] += coeffs[i];
+        for (size_t i = 0; i <= D2; ++i) c[i] += o[i];
+        return c;
+    }
+
+    template <size_t D2>
+    constexpr StaticPolynomial<T, (Degree > D2 ? Degree : D2)> operator-(const StaticPolynomial<T, D2>& o) const {
+        array<T, (Degree > D2 ? Degree : D2) + 1> c{};
+        for (size_t i = 0; i <= Degree; ++i) c[i] += coeffs[i];
+        for (size_t i = 0; i <= D2; ++i) c[i] -= o[i];
+        return c;
+    }
+
+    template <size_t D2>
+    constexpr StaticPolynomial<T, Degree + D2> operator*(const StaticPolynomial<T, D2>& o) const {
+        array<T, Degree + D2 + 1> c{};
+        for (size_t i = 0; i <= Degree; ++i)
+            for (size_t j = 0; j <= D2; ++j)
+                c[i + j] += coeffs[i] * o[j];
+        return c;
+    }
+
+    // Same root finders as Polynomial, allocation-free and usable in constant expressions
+    constexpr T newtonRaphson(T guess, int max_iter = 1000) const {
+        return newtonRaphsonOf(*this, guess, max_iter);
+    }
+
+    constexpr T bisection(T a, T b, int max_iter = 1000) const {
+        return bisectionOf(*this, a, b, max_iter);
+    }
+
+    void print() const { static_cast<Polynomial>(*this).print(); }
+
+private:
+    template <size_t... I>
+    constexpr T horner(T x, index_sequence<I...>) const {
+        T result = T(0);
+        ((result = result * x + coeffs[Degree - I]), ...);
+        return result;
     }
 };
 
+template <class T, class... Ts>
+StaticPolynomial(T, Ts...) -> StaticPolynomial<T, sizeof...(Ts)>;
+
+// Solves many polynomials across threads; each worker claims the next
+// polynomial from a shared counter, so uneven degrees balance out
+vector<RootResult> allRootsBatch(const vector<Polynomial>& polys, unsigned num_threads = 0) {
+    if (num_threads == 0) num_threads = max(1u, thread::hardware_concurrency());
+    vector<RootResult> results(polys.size());
+    atomic<size_t> next{0};
+
+    vector<thread> workers;
+    for (unsigned t = 0; t < num_threads; ++t)
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < polys.size(); i = next++)
+                results[i] = polys[i].allRoots();
+        });
+    for (auto& w : workers) w.join();
+    return results;
+}
+
 // ----------- Main function to test Polynomial class -------------
 int main() {
     Polynomial p1({-6, 11, -6, 1}); // Represents x^3 - 6x^2 + 11x - 6
@@ -142,5 +1080,194 @@ int main() {
         cerr << "Root finding failed: " << e.what() << endl;
     }
 
+    // All roots at once, complex ones included
+    Polynomial p3({1, 0, 0, 0, 1}); // x^4 + 1: four complex roots
+    for (const Polynomial* p : {&p1, &p3}) {
+        RootResult r = p->allRoots();
+        cout << "\nAll roots of ";
+        p->print();
+        for (size_t i = 0; i < r.roots.size(); ++i)
+            cout << "  " << r.roots[i] << "  (error bound " << r.error_bounds[i] << ")\n";
+        cout << "  " << r.method << ", " << r.iterations << " iterations\n";
+    }
+
+    // Batch mode: many random high-degree polynomials solved across threads
+    mt19937 rng(42);
+    normal_distribution<double> coeff(0.0, 1.0);
+    for (int deg : {50, 200, 500}) {
+        int count = deg == 500 ? 20 : 200;
+        vector<Polynomial> batch;
+        for (int k = 0; k < count; ++k) {
+            vector<double> c(deg + 1);
+            for (double& x : c) x = coeff(rng);
+            batch.emplace_back(c);
+        }
+        auto start = chrono::steady_clock::now();
+        vector<RootResult> results = allRootsBatch(batch);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        int converged = 0;
+        double worst = 0;
+        for (auto& r : results) {
+            converged += r.converged;
+            for (double e : r.error_bounds) worst = max(worst, e);
+        }
+        cout << "\nBatch degree " << deg << ": " << count << " polynomials in " << secs << " s ("
+             << count / secs << " per second), " << converged << " converged, worst error bound " << worst;
+    }
+    cout << endl;
+
+    // Multiplication crossover: time each algorithm on two random polynomials
+    // of the same degree, best of three runs; the error column is FFT against Karatsuba
+    cout << "\nDegree   Schoolbook(ms)  Karatsuba(ms)  FFT(ms)   Auto picks  max |FFT - Karatsuba|\n";
+    uniform_real_distribution<double> unit(-1.0, 1.0);
+    for (int deg = 16; deg <= 16384; deg *= 2) {
+        vector<double> ca(deg + 1), cb(deg + 1);
+        for (double& x : ca) x = unit(rng);
+        for (double& x : cb) x = unit(rng);
+        Polynomial pa(ca), pb(cb);
+
+        auto time_ms = [&](MulMethod m, Polynomial& out) {
+            int reps = max(1, 20000 / deg);
+            double best = numeric_limits<double>::infinity();
+            for (int run = 0; run < 3; ++run) {
+                auto start = chrono::steady_clock::now();
+                for (int r = 0; r < reps; ++r) out = pa.multiply(pb, m);
+                best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / reps);
+            }
+            return best;
+        };
+        Polynomial school({}), kara({}), fftp({});
+        double ts = time_ms(MulMethod::Schoolbook, school);
+        double tk = time_ms(MulMethod::Karatsuba, kara);
+        double tf = time_ms(MulMethod::FFT, fftp);
+
+        double err = 0;
+        for (size_t i = 0; i < kara.coefficients().size(); ++i)
+            err = max(err, fabs(kara.coefficients()[i] - fftp.coefficients()[i]));
+        MulMethod auto_method = pa.autoMethod(pb);
+        const char* pick = auto_method == MulMethod::Schoolbook ? "Schoolbook"
+                           : auto_method == MulMethod::Karatsuba ? "Karatsuba"
+                                                                 : "FFT";
+        printf("%-8d %-15.4f %-14.4f %-9.4f %-11s %.2e\n", deg, ts, tk, tf, pick, err);
+    }
+
+    // Real roots with no guess or bracket: verified Descartes isolation + safeguarded Newton
+    Polynomial repeated({2, -3, 0, 1});  // (x - 1)^2 (x + 2)
+    Polynomial close = Polynomial({-1, 1}) * Polynomial({-1.000001, 1});  // two roots 1e-6 apart
+    // Wilkinson (x-1)...(x-k): the rounded coefficients make the roots from 10 up very ill-conditioned
+    vector<Polynomial> wilkinson(4, Polynomial({1}));
+    const int wilkinson_degree[] = {10, 12, 18, 20};
+    for (int w = 0; w < 4; ++w)
+        for (int k = 1; k <= wilkinson_degree[w]; ++k) wilkinson[w] = wilkinson[w] * Polynomial({-double(k), 1});
+    // Chebyshev T_24 by T(n+1) = 2x T(n) - T(n-1): 24 simple roots packed into [-1, 1]
+    Polynomial t_prev({1}), cheb({0, 1});
+    for (int k = 1; k < 24; ++k) {
+        Polynomial t_next = Polynomial({0, 2}) * cheb - t_prev;
+        t_prev = cheb;
+        cheb = t_next;
+    }
+    vector<pair<string, const Polynomial*>> named{{"p1", &p1}, {"(x-1)^2 (x+2)", &repeated}, {"(x-1)(x-1.000001)", &close}};
+    for (int w = 0; w < 4; ++w) named.push_back({"(x-1)...(x-" + to_string(wilkinson_degree[w]) + ")", &wilkinson[w]});
+    named.push_back({"Chebyshev T_24", &cheb});
+    for (auto& [name, poly] : named) {
+        vector<double> roots = poly->realRoots(1e-14, 4);
+        double worst = 0;
+        if (poly == &cheb)
+            for (size_t k = 0; k < roots.size(); ++k)
+                worst = max(worst, fabs(roots[k] + cos((2 * k + 1) * acos(-1.0) / 48)));
+        else if (poly >= &wilkinson[0] && poly <= &wilkinson[3])
+            for (size_t k = 0; k < roots.size(); ++k) worst = max(worst, fabs(roots[k] - (k + 1.0)));
+        cout << "\nReal roots of " << name << " (" << roots.size() << "):";
+        streamsize digits = cout.precision(poly == &close ? 10 : cout.precision());
+        for (size_t k = 0; k < min<size_t>(roots.size(), 6); ++k) cout << " " << roots[k];
+        cout.precision(digits);
+        if (roots.size() > 6) cout << " ... max error " << worst;
+    }
+
+    // Random Gaussian polynomials of degree 2-31 against a dense long double
+    // sign scan of p over its root bound
+    mt19937 root_rng(7);
+    normal_distribution<double> gauss(0, 1);
+    int agree = 0;
+    const int random_polys = 100;
+    for (int t = 0; t < random_polys; ++t) {
+        vector<double> c(3 + t % 30);
+        for (double& x : c) x = gauss(root_rng);
+        double bound = 0;
+        for (size_t k = 1; k < c.size(); ++k)
+            bound = max(bound, pow(fabs(c[c.size() - 1 - k] / c.back()) / (k == c.size() - 1 ? 2 : 1), 1.0 / k));
+        bound *= 2.02;
+        int changes = 0;
+        long double last = 0;
+        for (int i = 0; i <= 200000; ++i) {
+            long double x = -bound + 2.0L * bound * i / 200000, v = 0;
+            for (size_t k = c.size(); k-- > 0;) v = v * x + c[k];
+            if (v != 0 && last != 0 && (v < 0) != (last < 0)) ++changes;
+            if (v != 0) last = v;
+        }
+        agree += int(Polynomial(c).realRoots().size()) == changes;
+    }
+    cout << "\nRandom polynomials whose real root count matches a sign scan: " << agree << "/" << random_polys;
+    cout << endl;
+
+    // Fixed-degree polynomials: the same cubic, checked at compile time
+    constexpr StaticPolynomial s1(-6.0, 11.0, -6.0, 1.0);
+    constexpr double s_root = s1.newtonRaphson(3.5);
+    static_assert(absValue(s_root - 3.0) < 1e-9, "compile-time Newton should find x = 3");
+    static_assert(s1.derivative().evaluate(2.0) == -1.0, "p'(2) = 3*4 - 24 + 11");
+    constexpr auto s_prod = s1 * s1.derivative();  // StaticPolynomial<double, 5>
+    static_assert(decltype(s_prod)::degree == 5, "product degree is in the type");
+
+    cout << "\nStaticPolynomial s1: ";
+    s1.print();
+    cout << "Compile-time Newton root near 3.5: " << s_root << endl;
+    Polynomial mixed = p1 + s1;  // converts to the dynamic class
+    cout << "p1 + s1 (dynamic): ";
+    mixed.print();
+
+    // Many Newton solves: the dynamic class walks a heap vector, the static
+    // one is fully inlined
+    const int solves = 1000000;
+    double sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < solves; ++i) sink += p1.newtonRaphson(3.5 + i * 1e-7);
+    double t_dyn = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < solves; ++i) sink += s1.newtonRaphson(3.5 + i * 1e-7);
+    double t_static = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << solves << " Newton solves: Polynomial " << t_dyn << " ms, StaticPolynomial " << t_static
+         << " ms (checksum " << sink / (2 * solves) << ")\n";
+
+    // Batch evaluation over a million points against one Horner call per point
+    const size_t points = 1 << 20;
+    vector<double> xs(points), ys(points), dys(points);
+    for (double& x : xs) x = unit(rng);
+    cout << "\nBatch evaluation of " << points << " points ("
+         << SimdLanes::width << " lanes per vector)\n";
+    cout << "Degree   Horner loop(ms)  Batch(ms)  Batch + derivative(ms)  max |batch - Horner|\n";
+    for (int deg : {4, 16, 64}) {
+        vector<double> c(deg + 1);
+        for (double& x : c) x = unit(rng);
+        Polynomial p(c);
+
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < points; ++i) ys[i] = p.evaluate(xs[i]);
+        double th = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        vector<double> reference = ys;
+        start = chrono::steady_clock::now();
+        p.evaluate(xs.data(), ys.data(), points);
+        double tb = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        p.evaluate(xs.data(), ys.data(), points, dys.data());
+        double td = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        double err = 0;
+        for (size_t i = 0; i < points; ++i) err = max(err, fabs(ys[i] - reference[i]));
+        printf("%-8d %-16.3f %-10.3f %-23.3f %.2e\n", deg, th, tb, td, err);
+    }
+
     return 0;
 }
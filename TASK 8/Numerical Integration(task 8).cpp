@@ -4,46 +4,805 @@
 #include <iostream>
 #include <cmath>
 #include <iomanip> // For formatting output with set precision
+#include <queue>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 // Define the function f(x) = e^x
 double f(double x) {
     return std::exp(x); // Built-in exponential function
 }
 
-// Trapezoidal Rule for numerical integration
-double trapezoidal(double a, double b, int n) {
+// Trapezoidal Rule for numerical integration of any callable g(double)
+template <class F>
+double trapezoidal(F&& g, double a, double b, int n) {
     double h = (b - a) / n;       // Step size
-    double sum = f(a) + f(b);     // Endpoints counted once
+    double sum = g(a) + g(b);     // Endpoints counted once
 
-    // Add 2 * f(x_i) for interior points
+    // Add 2 * g(x_i) for interior points
     for (int i = 1; i < n; ++i) {
-        sum += 2 * f(a + i * h);
+        sum += 2 * g(a + i * h);
     }
 
     return (h / 2) * sum; // Final result
 }
 
-// Simpson's Rule for numerical integration
-double simpson(double a, double b, int n) {
+// Simpson's Rule for numerical integration of any callable g(double)
+template <class F>
+double simpson(F&& g, double a, double b, int n) {
     if (n % 2 != 0) n++; // Simpson's Rule needs even number of intervals
 
     double h = (b - a) / n;
-    double sum = f(a) + f(b); // Add endpoints
+    double sum = g(a) + g(b); // Add endpoints
 
-    // Alternate weights: 4 for odd-indexed, 2 for even-indexed points
-    for (int i = 1; i < n; ++i) {
-        if (i % 2 == 0)
-            sum += 2 * f(a + i * h);
-        else
-            sum += 4 * f(a + i * h);
-    }
+    // Weight 4 for odd-indexed points, 2 for even-indexed ones: two strided
+    // loops instead of a parity test per point
+    double odd = 0, even = 0;
+    for (int i = 1; i < n; i += 2) odd += g(a + i * h);
+    for (int i = 2; i < n; i += 2) even += g(a + i * h);
+    sum += 4 * odd + 2 * even;
 
     return (h / 3) * sum; // Final result
 }
 
+// The original interface, integrating the global f
+double trapezoidal(double a, double b, int n) { return trapezoidal(f, a, b, n); }
+double simpson(double a, double b, int n) { return simpson(f, a, b, n); }
+
+// ---- Batch and parallel fixed-step integration ----
+
+// A batch integrand fills ys[0..count) with its values at xs[0..count), so one
+// call covers a whole block and the loop inside can vectorise.
+// batched() wraps a scalar callable into that form.
+template <class F>
+auto batched(F g) {
+    return [g](const double* xs, double* ys, size_t count) {
+        for (size_t j = 0; j < count; ++j) ys[j] = g(xs[j]);
+    };
+}
+
+enum class FixedRule { Trapezoidal, Simpson };
+
+const size_t INTEGRATION_BLOCK = 256;   // points per batch call
+const size_t INTEGRATION_CHUNK = 16384; // points per work item; fixed, so results never depend on thread count
+
+// Kahan-compensated running sum
+struct KahanSum {
+    double sum = 0, carry = 0;
+    void add(double x) {
+        double y = x - carry;
+        double t = sum + y;
+        carry = (t - sum) - y;
+        sum = t;
+    }
+};
+
+// Pairwise (tree) sum of v[lo, hi): error grows with log n rather than n
+inline double pairwiseSum(const std::vector<double>& v, size_t lo, size_t hi) {
+    if (hi - lo == 0) return 0;
+    if (hi - lo == 1) return v[lo];
+    size_t mid = lo + (hi - lo) / 2;
+    return pairwiseSum(v, lo, mid) + pairwiseSum(v, mid, hi);
+}
+
+// Trapezoidal or Simpson over n intervals with a batch integrand, split
+// across threads. The points 0..n are cut into fixed chunks, and threads claim
+// chunks from a shared counter. Each chunk Kahan-sums its block sums into its
+// own slot, and the slots are then summed pairwise in chunk order.
+// The answer is therefore bit-identical for any num_threads.
+template <class G>
+double integrateParallel(G&& batch, double a, double b, long n, FixedRule rule, unsigned num_threads = 0) {
+    if (rule == FixedRule::Simpson && n % 2 != 0) n++;
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    const double h = (b - a) / n;
+    const size_t points = size_t(n) + 1;
+    const size_t chunks = (points + INTEGRATION_CHUNK - 1) / INTEGRATION_CHUNK;
+    std::vector<double> partial(chunks);
+    std::atomic<size_t> next{0};
+
+    auto work = [&]() {
+        double xs[INTEGRATION_BLOCK], ys[INTEGRATION_BLOCK];
+        for (size_t c = next++; c < chunks; c = next++) {
+            KahanSum acc;
+            size_t end = std::min(points, (c + 1) * INTEGRATION_CHUNK);
+            for (size_t start = c * INTEGRATION_CHUNK; start < end; start += INTEGRATION_BLOCK) {
+                size_t count = std::min(INTEGRATION_BLOCK, end - start);
+                for (size_t j = 0; j < count; ++j) xs[j] = a + double(start + j) * h;
+                if (start + count == points) xs[count - 1] = b; // Land exactly on b
+                batch(xs, ys, count);
+
+                // Interior weights: 2 for trapezoidal; 4 (odd) and 2 (even) for Simpson.
+                // Endpoints get half the even weight, fixed up after the sum. A block
+                // is short enough to sum plainly (and vectorised); blocks are then
+                // combined with Kahan compensation.
+                double block = 0;
+                if (rule == FixedRule::Trapezoidal) {
+                    for (size_t j = 0; j < count; ++j) block += ys[j];
+                    block *= 2;
+                } else {
+                    double odd = 0, even = 0;
+                    size_t first_odd = (start % 2 == 0) ? 1 : 0;
+                    for (size_t j = first_odd; j < count; j += 2) odd += ys[j];
+                    for (size_t j = 1 - first_odd; j < count; j += 2) even += ys[j];
+                    block = 4 * odd + 2 * even;
+                }
+                if (start == 0) block -= ys[0];
+                if (start + count == points) block -= ys[count - 1];
+                acc.add(block);
+            }
+            partial[c] = acc.sum;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < num_threads; ++t) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+
+    double sum = pairwiseSum(partial, 0, chunks);
+    return rule == FixedRule::Trapezoidal ? (h / 2) * sum : (h / 3) * sum;
+}
+
+// ---- Adaptive Gauss-Kronrod quadrature ----
+
+// Result of an adaptive integration
+struct IntegrationResult {
+    double value = 0;      // Integral estimate
+    double error = 0;      // Estimated absolute error
+    long evaluations = 0;  // Number of integrand calls
+    int intervals = 0;     // Subintervals in the final partition
+    bool converged = false;
+};
+
+enum class GaussKronrodRule { GK15, GK21 }; // Gauss 7 / Kronrod 15 and Gauss 10 / Kronrod 21
+
+struct AdaptiveOptions {
+    double abs_tol = 1e-10;
+    double rel_tol = 1e-10;  // Stop when error <= max(abs_tol, rel_tol * |value|)
+    GaussKronrodRule rule = GaussKronrodRule::GK21;
+    int max_intervals = 2000;
+    bool endpoint_singularities = false; // Substitute x = a + (b - a)(3t^2 - 2t^3) to smooth endpoint blow-ups; finite limits only
+};
+
+// Kronrod nodes on [0, 1) with Kronrod and embedded Gauss weights (QUADPACK tables).
+// Odd-indexed Kronrod nodes are the Gauss nodes; the centre node comes last.
+const double GK15_NODES[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+const double GK15_WEIGHTS[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+const double G7_WEIGHTS[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+const double GK21_NODES[11] = {
+    0.995657163025808080735527280689003, 0.973906528517171720077964012084452,
+    0.930157491355708226001207180059508, 0.865063366688984510732096688423493,
+    0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+    0.562757134668604683339000099272694, 0.433395394129247190799265943165784,
+    0.294392862701460198131126603103866, 0.148874338981631210884826001129720,
+    0.000000000000000000000000000000000};
+const double GK21_WEIGHTS[11] = {
+    0.011694638867371874278064396062192, 0.032558162307964727478818972459390,
+    0.054755896574351996031381300244580, 0.075039674810919952767043140916190,
+    0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+    0.123491976262065851077600445571325, 0.134709217311473325928054001771707,
+    0.142775938577060080797094273138717, 0.147739104901338491374841515972068,
+    0.149445554002916905664936468389821};
+const double G10_WEIGHTS[5] = {
+    0.066671344308688137593568809893332, 0.149451349150580593145776339657697,
+    0.219086362515982043995534934228163, 0.269266719309996355091226921569469,
+    0.295524224714752870173892994651338};
+
+struct Subinterval {
+    double a, b, value, error;
+    bool operator<(const Subinterval& o) const { return error < o.error; } // Max-heap on error
+};
+
+// One Kronrod rule on [a, b] plus its QUADPACK error estimate, which scales
+// |Kronrod - Gauss| and never reports less than the rounding level
+template <class F>
+Subinterval gaussKronrod(F& f, double a, double b, GaussKronrodRule rule) {
+    const bool k21 = rule == GaussKronrodRule::GK21;
+    const int n = k21 ? 11 : 8;
+    const double* x = k21 ? GK21_NODES : GK15_NODES;
+    const double* wk = k21 ? GK21_WEIGHTS : GK15_WEIGHTS;
+    const double* wg = k21 ? G10_WEIGHTS : G7_WEIGHTS;
+
+    double centre = (a + b) / 2, half = (b - a) / 2;
+    double f_centre = f(centre);
+    double kronrod = wk[n - 1] * f_centre;
+    double gauss = k21 ? 0.0 : wg[3] * f_centre; // G10 has no centre node
+    double abs_sum = std::abs(kronrod);
+    double fv1[10], fv2[10];
+    for (int j = 0; j < n - 1; ++j) {
+        double f1 = f(centre - half * x[j]), f2 = f(centre + half * x[j]);
+        fv1[j] = f1;
+        fv2[j] = f2;
+        kronrod += wk[j] * (f1 + f2);
+        abs_sum += wk[j] * (std::abs(f1) + std::abs(f2));
+        if (j % 2 == 1) gauss += wg[j / 2] * (f1 + f2);
+    }
+
+    double mean = kronrod / 2;
+    double asc = wk[n - 1] * std::abs(f_centre - mean);
+    for (int j = 0; j < n - 1; ++j)
+        asc += wk[j] * (std::abs(fv1[j] - mean) + std::abs(fv2[j] - mean));
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    double err = std::abs((kronrod - gauss) * half);
+    asc *= std::abs(half);
+    abs_sum *= std::abs(half);
+    if (asc != 0 && err != 0) err = asc * std::min(1.0, std::pow(200 * err / asc, 1.5));
+    if (abs_sum > std::numeric_limits<double>::min() / (50 * eps)) err = std::max(50 * eps * abs_sum, err);
+    return {a, b, kronrod * half, err};
+}
+
+// Adaptive integration of any callable over [a, b]. Subintervals wait in a
+// priority queue ordered by error estimate; the worst one is bisected until
+// the total error meets the tolerance. Infinite limits are mapped onto a
+// finite t-range (x = a + t/(1-t) and friends), so a and b may be +-infinity.
+// A subinterval whose value or error is not finite (f hit a singularity) is
+// split first and leaves the result unconverged while it lasts.
+template <class F>
+IntegrationResult integrateAdaptive(F f, double a, double b, const AdaptiveOptions& opt = {}) {
+    if (opt.endpoint_singularities && (std::isinf(a) || std::isinf(b)))
+        throw std::invalid_argument("endpoint_singularities needs finite limits.");
+    IntegrationResult result;
+    double sign = 1;
+    if (b < a) {
+        std::swap(a, b);
+        sign = -1;
+    }
+
+    // Every transform is x = map(t) with Jacobian x'(t), integrated over t in [lo, hi]
+    const double inf = std::numeric_limits<double>::infinity();
+    auto g = [&](double t) -> double {
+        ++result.evaluations;
+        if (a == -inf && b == inf) {          // x = t / (1 - t^2), t in (-1, 1)
+            double d = 1 - t * t;
+            return f(t / d) * (1 + t * t) / (d * d);
+        }
+        if (b == inf) {                       // x = a + t / (1 - t), t in [0, 1)
+            double d = 1 - t;
+            return f(a + t / d) / (d * d);
+        }
+        if (a == -inf) {                      // x = b - (1 - t) / t, t in (0, 1]
+            return f(b - (1 - t) / t) / (t * t);
+        }
+        if (opt.endpoint_singularities) {     // x = a + (b - a)(3t^2 - 2t^3), t in [0, 1]
+            double x = a + (b - a) * t * t * (3 - 2 * t);
+            return f(x) * 6 * t * (1 - t) * (b - a);
+        }
+        return f(t);
+    };
+    double lo = a, hi = b;
+    if (a == -inf && b == inf) { lo = -1; hi = 1; }
+    else if (a == -inf || b == inf || opt.endpoint_singularities) { lo = 0; hi = 1; }
+
+    // Non-finite subintervals get error = inf, so they top the heap, and are
+    // counted apart from the running totals so inf - inf never reaches them
+    double total = 0, total_err = 0;
+    int non_finite = 0;
+    auto estimate = [&](double x0, double x1) {
+        Subinterval s = gaussKronrod(g, x0, x1, opt.rule);
+        if (!std::isfinite(s.value) || !std::isfinite(s.error)) s.error = inf;
+        return s;
+    };
+    auto account = [&](const Subinterval& s, int dir) {
+        if (s.error == inf) non_finite += dir;
+        else {
+            total += dir * s.value;
+            total_err += dir * s.error;
+        }
+    };
+    std::priority_queue<Subinterval> heap;
+    heap.push(estimate(lo, hi));
+    account(heap.top(), 1);
+
+    while ((int)heap.size() < opt.max_intervals) {
+        if (non_finite == 0 && total_err <= std::max(opt.abs_tol, opt.rel_tol * std::abs(total))) {
+            result.converged = true;
+            break;
+        }
+        Subinterval worst = heap.top();
+        double mid = (worst.a + worst.b) / 2;
+        if (mid <= worst.a || mid >= worst.b) break; // Cannot split further
+        heap.pop();
+        Subinterval left = estimate(worst.a, mid);
+        Subinterval right = estimate(mid, worst.b);
+        account(worst, -1);
+        account(left, 1);
+        account(right, 1);
+        heap.push(left);
+        heap.push(right);
+    }
+
+    // Re-sum so running-total rounding does not leak into the result
+    result.intervals = (int)heap.size();
+    total = total_err = 0;
+    for (; !heap.empty(); heap.pop()) {
+        total += heap.top().value;
+        total_err += heap.top().error;
+    }
+    if (!result.converged)
+        result.converged = std::isfinite(total) && std::isfinite(total_err) &&
+                           total_err <= std::max(opt.abs_tol, opt.rel_tol * std::abs(total));
+    result.value = sign * total;
+    result.error = total_err;
+    return result;
+}
+
+// ---- Incremental Romberg integration ----
+
+// Romberg integration that keeps every sample. Each refinement halves the
+// step and evaluates only the new midpoints (the trapezoid estimate becomes
+// T(h/2) = T(h)/2 + (h/2) * sum of midpoints). Richardson extrapolation
+// R[k][j] = R[k][j-1] + (R[k][j-1] - R[k-1][j-1]) / (4^j - 1) then removes
+// the h^2, h^4, ... error terms. Calling integrate() again with a tighter
+// tolerance resumes from the current table. samples() can be saved and passed
+// back to the constructor, which rebuilds the table without re-evaluating.
+template <class F>
+class Romberg {
+public:
+    Romberg(F g, double a, double b) : g(g), a(a), b(b) {
+        values = {g(a), g(b)};
+        evaluations = 2;
+        table.push_back({(b - a) / 2 * (values[0] + values[1])});
+    }
+
+    // Resume from saved samples: f at 2^k + 1 equally spaced points on [a, b]
+    Romberg(F g, double a, double b, std::vector<double> saved) : g(g), a(a), b(b), values(std::move(saved)) {
+        size_t intervals = values.size() - 1;
+        if (values.size() < 2 || (intervals & (intervals - 1)) != 0)
+            throw std::invalid_argument("Romberg samples must cover 2^k + 1 points.");
+        for (size_t n = 1; n <= intervals; n *= 2) {
+            size_t stride = intervals / n;
+            double sum = (values.front() + values.back()) / 2;
+            for (size_t i = stride; i < intervals; i += stride) sum += values[i];
+            addRow(sum * (b - a) / n);
+        }
+    }
+
+    // Refine until successive diagonal entries agree to max(abs_tol, rel_tol * |R|)
+    IntegrationResult integrate(double abs_tol = 1e-10, double rel_tol = 1e-10, int max_levels = 25) {
+        IntegrationResult result;
+        while (true) {
+            size_t k = table.size() - 1;
+            if (k >= MIN_LEVELS) {
+                result.value = table[k][k];
+                result.error = std::abs(table[k][k] - table[k - 1][k - 1]);
+                if (result.error <= std::max(abs_tol, rel_tol * std::abs(result.value))) {
+                    result.converged = true;
+                    break;
+                }
+            }
+            if ((int)k >= max_levels) break;
+            refine();
+        }
+        size_t k = table.size() - 1;
+        result.value = table[k][k];
+        result.evaluations = evaluations;
+        result.intervals = int(values.size() - 1);
+        return result;
+    }
+
+    // Samples in grid order: values()[i] = g(a + i (b - a) / (size - 1))
+    const std::vector<double>& samples() const { return values; }
+    const std::vector<std::vector<double>>& extrapolationTable() const { return table; }
+
+private:
+    static const size_t MIN_LEVELS = 4; // Guard against early agreement on coarse grids
+
+    // Halve the step: evaluate only the midpoints, then interleave them with the old samples
+    void refine() {
+        size_t n = values.size() - 1;
+        double h = (b - a) / (2 * n);
+        std::vector<double> next(2 * n + 1);
+        double mid_sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            next[2 * i] = values[i];
+            next[2 * i + 1] = g(a + (2 * i + 1) * h);
+            mid_sum += next[2 * i + 1];
+        }
+        next[2 * n] = values[n];
+        evaluations += long(n);
+        values.swap(next);
+        addRow(table.back()[0] / 2 + h * mid_sum);
+    }
+
+    void addRow(double trapezoid) {
+        std::vector<double> row{trapezoid};
+        double factor = 1;
+        for (size_t j = 1; j <= table.size(); ++j) {
+            factor *= 4;
+            row.push_back(row[j - 1] + (row[j - 1] - table.back()[j - 1]) / (factor - 1));
+        }
+        table.push_back(row);
+    }
+
+    F g;
+    double a, b;
+    std::vector<double> values;
+    std::vector<std::vector<double>> table;
+    long evaluations = 0;
+};
+
+// ---- Multidimensional cubature ----
+
+// Persistent worker threads for parallel loops: run(count, body) calls
+// body(i) for every i in [0, count) on the workers and the calling thread,
+// and returns once all are done
+class ParallelFor {
+public:
+    explicit ParallelFor(unsigned num_threads = 0) {
+        if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 1; t < num_threads; ++t)
+            workers.emplace_back([this]() { workerLoop(); });
+    }
+
+    ~ParallelFor() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        start_cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    void run(size_t count, const std::function<void(size_t)>& body) {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            job = &body;
+            job_count = count;
+            next = 0;
+            busy = workers.size();
+            ++generation;
+        }
+        start_cv.notify_all();
+        drain();
+        std::unique_lock<std::mutex> lock(m);
+        done_cv.wait(lock, [this]() { return busy == 0; });
+    }
+
+private:
+    void drain() {
+        for (size_t i = next++; i < job_count; i = next++) (*job)(i);
+    }
+
+    void workerLoop() {
+        unsigned seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                start_cv.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) return;
+                seen = generation;
+            }
+            drain();
+            std::lock_guard<std::mutex> lock(m);
+            if (--busy == 0) done_cv.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable start_cv, done_cv;
+    const std::function<void(size_t)>* job = nullptr;
+    size_t job_count = 0, busy = 0;
+    std::atomic<size_t> next{0};
+    unsigned generation = 0;
+    bool stop = false;
+};
+
+// Multidimensional integrands are batch callables too: g(points, values, count)
+// with points row-major, count x dim. batchedPoints() wraps a scalar g(const double* x).
+template <class F>
+auto batchedPoints(F g, size_t dim) {
+    return [g, dim](const double* points, double* values, size_t count) {
+        for (size_t j = 0; j < count; ++j) values[j] = g(points + j * dim);
+    };
+}
+
+enum class CubatureMethod { Auto, GenzMalik, Smolyak };
+
+struct CubatureOptions {
+    double abs_tol = 1e-8;
+    double rel_tol = 1e-8;  // Stop when error <= max(abs_tol, rel_tol * |value|)
+    CubatureMethod method = CubatureMethod::Auto; // Auto: Genz-Malik up to GENZ_MALIK_MAX_DIM, Smolyak above
+    long max_evaluations = 10000000;
+    int max_level = 8;      // Smolyak: highest sparse-grid level
+    unsigned threads = 0;
+};
+
+const size_t GENZ_MALIK_MAX_DIM = 6;   // 2^d corner points per region make it costly beyond this
+const size_t CUBATURE_SPLIT_BATCH = 16; // regions split per round; fixed, so results never depend on thread count
+const int SMOLYAK_MIN_LEVEL = 4;        // coarse sparse grids can agree by accident (e.g. all on zeros of f)
+
+// Genz-Malik degree-7 rule with an embedded degree-5 rule on one hyper-rectangle
+struct CubatureRegion {
+    std::vector<double> centre, half;
+    double value = 0, error = 0;
+    size_t split_dim = 0;
+    bool operator<(const CubatureRegion& o) const { return error < o.error; }
+};
+
+template <class G>
+void genzMalik(G& g, CubatureRegion& r) {
+    const size_t d = r.centre.size();
+    const double l2 = std::sqrt(9.0 / 70), l4 = std::sqrt(9.0 / 10), l5 = std::sqrt(9.0 / 19);
+    const double dd = double(d);
+    const double w1 = (12824 - 9120 * dd + 400 * dd * dd) / 19683, w2 = 980.0 / 6561,
+                 w3 = (1820 - 400 * dd) / 19683, w4 = 200.0 / 19683, w5 = 6859.0 / 19683 / std::ldexp(1.0, int(d));
+    const double v1 = (729 - 950 * dd + 50 * dd * dd) / 729, v2 = 245.0 / 486,
+                 v3 = (265 - 100 * dd) / 1458, v4 = 25.0 / 729;
+
+    // Points: centre, +-l2 and +-l4 along each axis, +-l4 on every pair of axes, and the 2^d corners at l5
+    std::vector<double> pts;
+    auto add = [&](const std::vector<double>& offset) {
+        for (size_t k = 0; k < d; ++k) pts.push_back(r.centre[k] + r.half[k] * offset[k]);
+    };
+    std::vector<double> off(d, 0.0);
+    add(off);
+    for (size_t i = 0; i < d; ++i)
+        for (double l : {l2, -l2, l4, -l4}) {
+            off[i] = l;
+            add(off);
+            off[i] = 0;
+        }
+    for (size_t i = 0; i < d; ++i)
+        for (size_t j = i + 1; j < d; ++j)
+            for (double si : {l4, -l4})
+                for (double sj : {l4, -l4}) {
+                    off[i] = si;
+                    off[j] = sj;
+                    add(off);
+                    off[i] = off[j] = 0;
+                }
+    for (size_t mask = 0; mask < (size_t(1) << d); ++mask) {
+        for (size_t k = 0; k < d; ++k) off[k] = (mask >> k & 1) ? -l5 : l5;
+        add(off);
+    }
+    std::vector<double> f(pts.size() / d);
+    g(pts.data(), f.data(), f.size());
+
+    double f0 = f[0], sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0, worst = -1;
+    size_t idx = 1;
+    for (size_t i = 0; i < d; ++i, idx += 4) {
+        double s2 = f[idx] + f[idx + 1], s3 = f[idx + 2] + f[idx + 3];
+        sum2 += s2;
+        sum3 += s3;
+        // Fourth difference along axis i picks the split direction
+        double diff = std::abs(s2 - 2 * f0 - (l2 * l2) / (l4 * l4) * (s3 - 2 * f0));
+        if (diff > worst) {
+            worst = diff;
+            r.split_dim = i;
+        }
+    }
+    for (size_t k = 0; k < 2 * d * (d - 1); ++k) sum4 += f[idx++];
+    for (; idx < f.size(); ++idx) sum5 += f[idx];
+
+    double volume = 1;
+    for (double h : r.half) volume *= 2 * h;
+    double deg7 = w1 * f0 + w2 * sum2 + w3 * sum3 + w4 * sum4 + w5 * sum5;
+    double deg5 = v1 * f0 + v2 * sum2 + v3 * sum3 + v4 * sum4;
+    r.value = volume * deg7;
+    r.error = volume * std::abs(deg7 - deg5);
+}
+
+// Adaptive Genz-Malik: each round splits the CUBATURE_SPLIT_BATCH worst
+// regions in half along their roughest axis and evaluates the children in parallel
+template <class G>
+IntegrationResult genzMalikCubature(G& g, const std::vector<double>& lower, const std::vector<double>& upper,
+                                    const CubatureOptions& opt, ParallelFor& pool) {
+    const size_t d = lower.size();
+    const long points_per_region = long((size_t(1) << d) + 2 * d * d + 2 * d + 1);
+    IntegrationResult result;
+
+    CubatureRegion root;
+    for (size_t k = 0; k < d; ++k) {
+        root.centre.push_back((lower[k] + upper[k]) / 2);
+        root.half.push_back((upper[k] - lower[k]) / 2);
+    }
+    genzMalik(g, root);
+    result.evaluations = points_per_region;
+    std::priority_queue<CubatureRegion> heap;
+    double total = root.value, total_err = root.error;
+    heap.push(std::move(root));
+
+    while (total_err > std::max(opt.abs_tol, opt.rel_tol * std::abs(total)) &&
+           result.evaluations + 2 * long(CUBATURE_SPLIT_BATCH) * points_per_region <= opt.max_evaluations) {
+        std::vector<CubatureRegion> children;
+        for (size_t k = 0; k < CUBATURE_SPLIT_BATCH && !heap.empty(); ++k) {
+            CubatureRegion parent = heap.top();
+            heap.pop();
+            total -= parent.value;
+            total_err -= parent.error;
+            size_t s = parent.split_dim;
+            parent.half[s] /= 2;
+            CubatureRegion left = parent, right = parent;
+            left.centre[s] -= parent.half[s];
+            right.centre[s] += parent.half[s];
+            children.push_back(std::move(left));
+            children.push_back(std::move(right));
+        }
+        pool.run(children.size(), [&](size_t i) { genzMalik(g, children[i]); });
+        for (auto& c : children) {
+            total += c.value;
+            total_err += c.error;
+            heap.push(std::move(c));
+        }
+        result.evaluations += long(children.size()) * points_per_region;
+    }
+
+    result.intervals = int(heap.size());
+    total = total_err = 0;
+    for (; !heap.empty(); heap.pop()) {
+        total += heap.top().value;
+        total_err += heap.top().error;
+    }
+    result.value = total;
+    result.error = total_err;
+    result.converged = total_err <= std::max(opt.abs_tol, opt.rel_tol * std::abs(total));
+    return result;
+}
+
+// Nested Clenshaw-Curtis rule on [0, 1]: level 1 is the midpoint, level l has
+// 2^(l-1) + 1 points at (1 - cos(k pi / n)) / 2. Points are returned as indices
+// k on the finest level (n = 2^(max_level-1)), so a point shared between
+// levels always gets the same key.
+inline void clenshawCurtis(int level, int max_level, std::vector<int>& index, std::vector<double>& weight) {
+    const int fine = 1 << (max_level - 1);
+    index.clear();
+    weight.clear();
+    if (level == 1) {
+        index.push_back(fine / 2);
+        weight.push_back(1.0);
+        return;
+    }
+    const int n = 1 << (level - 1); // intervals
+    const double pi = std::acos(-1.0);
+    for (int k = 0; k <= n; ++k) {
+        double sum = 0;
+        for (int j = 1; j <= n / 2; ++j) {
+            double bj = (j == n / 2) ? 1.0 : 2.0;
+            sum += bj / (4.0 * j * j - 1) * std::cos(2.0 * j * k * pi / n);
+        }
+        double ck = (k == 0 || k == n) ? 1.0 : 2.0;
+        index.push_back(k * (fine / n));
+        weight.push_back(ck / n * (1 - sum) / 2);
+    }
+}
+
+// Smolyak sparse grid by the combination technique:
+// A(q, d) = sum over q-d+1 <= |l| <= q of (-1)^(q-|l|) C(d-1, q-|l|) (U^l1 x ... x U^ld),
+// with q = d + level - 1. Tensor grids are merged into one weight per unique
+// point. Function values are cached across levels, so raising the level only
+// evaluates new points. The error estimate is |A(level) - A(level - 1)|; it
+// counts as converged from SMOLYAK_MIN_LEVEL on, and only once two successive
+// differences are within tolerance.
+template <class G>
+IntegrationResult smolyakCubature(G& g, const std::vector<double>& lower, const std::vector<double>& upper,
+                                  const CubatureOptions& opt, ParallelFor& pool) {
+    const size_t d = lower.size();
+    const int max_level = opt.max_level;
+    const double fine = double(1 << (max_level - 1)), pi = std::acos(-1.0);
+    double volume = 1;
+    for (size_t k = 0; k < d; ++k) volume *= upper[k] - lower[k];
+
+    std::vector<std::vector<int>> cc_index(max_level + 1);
+    std::vector<std::vector<double>> cc_weight(max_level + 1);
+    for (int l = 1; l <= max_level; ++l) clenshawCurtis(l, max_level, cc_index[l], cc_weight[l]);
+
+    std::map<std::vector<int>, double> cache; // point -> f
+    IntegrationResult result;
+    double previous = 0;
+    int small_steps = 0; // successive levels whose difference is within tolerance
+    for (int level = 1; level <= max_level; ++level) {
+        const int q = int(d) + level - 1;
+        std::map<std::vector<int>, double> weights;
+
+        // Enumerate multi-indices l >= 1 with q - d + 1 <= |l| <= q
+        std::vector<int> l(d, 1);
+        std::function<void(size_t, int)> visit = [&](size_t dim, int used) {
+            if (dim == d) {
+                if (used < q - int(d) + 1) return;
+                int k = q - used;
+                double binom = 1;
+                for (int i = 0; i < k; ++i) binom = binom * (int(d) - 1 - i) / (i + 1);
+                double coeff = (k % 2 ? -1.0 : 1.0) * binom;
+                // Tensor product of the 1-D rules U^l1 x ... x U^ld
+                std::vector<size_t> pos(d, 0);
+                std::vector<int> key(d);
+                while (true) {
+                    double w = coeff;
+                    for (size_t i = 0; i < d; ++i) {
+                        key[i] = cc_index[l[i]][pos[i]];
+                        w *= cc_weight[l[i]][pos[i]];
+                    }
+                    weights[key] += w;
+                    size_t i = 0;
+                    while (i < d && ++pos[i] == cc_index[l[i]].size()) pos[i++] = 0;
+                    if (i == d) break;
+                }
+                return;
+            }
+            for (int li = 1; used + li + int(d - dim - 1) <= q && li <= max_level; ++li) {
+                l[dim] = li;
+                visit(dim + 1, used + li);
+            }
+        };
+        visit(0, 0);
+
+        // Evaluate only the points not seen at earlier levels, in parallel blocks
+        std::vector<const std::vector<int>*> fresh;
+        for (auto& kv : weights)
+            if (!cache.count(kv.first)) fresh.push_back(&kv.first);
+        if (result.evaluations + long(fresh.size()) > opt.max_evaluations) break;
+        std::vector<double> values(fresh.size());
+        const size_t block = 256;
+        pool.run((fresh.size() + block - 1) / block, [&](size_t b) {
+            size_t start = b * block, count = std::min(block, fresh.size() - start);
+            std::vector<double> pts(count * d);
+            for (size_t j = 0; j < count; ++j)
+                for (size_t k = 0; k < d; ++k)
+                    pts[j * d + k] = lower[k] + (upper[k] - lower[k]) * (1 - std::cos(pi * (*fresh[start + j])[k] / fine)) / 2;
+            g(pts.data(), values.data() + start, count);
+        });
+        for (size_t j = 0; j < fresh.size(); ++j) cache[*fresh[j]] = values[j];
+        result.evaluations += long(fresh.size());
+
+        double sum = 0;
+        for (auto& kv : weights) sum += kv.second * cache[kv.first];
+        result.value = volume * sum;
+        result.intervals = level;
+        if (level > 1) {
+            result.error = std::abs(result.value - previous);
+            bool small = result.error <= std::max(opt.abs_tol, opt.rel_tol * std::abs(result.value));
+            small_steps = small ? small_steps + 1 : 0;
+            if (level >= SMOLYAK_MIN_LEVEL && small_steps >= 2) {
+                result.converged = true;
+                break;
+            }
+        }
+        previous = result.value;
+    }
+    return result;
+}
+
+// Integrates a batch integrand over the box [lower, upper]. intervals in the
+// result counts regions (Genz-Malik) or the final level (Smolyak).
+template <class G>
+IntegrationResult integrateCubature(G g, const std::vector<double>& lower, const std::vector<double>& upper,
+                                    const CubatureOptions& opt = {}) {
+    if (lower.size() != upper.size() || lower.empty())
+        throw std::invalid_argument("Cubature bounds must have the same, nonzero dimension.");
+    CubatureMethod method = opt.method;
+    if (method == CubatureMethod::Auto)
+        method = lower.size() <= GENZ_MALIK_MAX_DIM ? CubatureMethod::GenzMalik : CubatureMethod::Smolyak;
+    ParallelFor pool(opt.threads);
+    return method == CubatureMethod::GenzMalik ? genzMalikCubature(g, lower, upper, opt, pool)
+                                               : smolyakCubature(g, lower, upper, opt, pool);
+}
+
 int main() {
     double a = 0.0, b = 1.0;         // Integration interval [a, b]
-    double exact = 1.71828;          // Approximate true value of ∫e^x dx from 0 to 1
+    double exact = std::exp(1.0) - 1; // True value of ∫e^x dx from 0 to 1
     int ns[] = {10, 100, 1000};      // Different numbers of intervals for testing
 
     std::cout << std::fixed << std::setprecision(5); // Format output to 5 decimal places
@@ -61,5 +820,124 @@ int main() {
         std::cout << "Simpson's Result   = " << simpson_result << ", Error = " << simpson_error << "\n\n";
     }
 
+    // Any callable: a lambda with captured state instead of the global f
+    double k = 3.0;
+    auto damped = [k](double x) { return std::exp(-k * x) * std::sin(k * x); };
+    double damped_exact = (1 - std::exp(-k) * (std::sin(k) + std::cos(k))) / (2 * k);
+    std::cout << "Simpson, n = 1000, on e^(-3x) sin(3x): " << simpson(damped, a, b, 1000)
+              << ", Error = " << std::abs(simpson(damped, a, b, 1000) - damped_exact) << "\n\n";
+
+    // Batch integrand over threads: same bits for every thread count
+    auto exp_block = [](const double* xs, double* ys, size_t count) {
+        for (size_t j = 0; j < count; ++j) ys[j] = std::exp(xs[j]);
+    };
+    const long big_n = 20000000;
+    std::cout << "Parallel Simpson, n = " << big_n << ", batch integrand e^x:\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        auto start = std::chrono::steady_clock::now();
+        double r = integrateParallel(exp_block, a, b, big_n, FixedRule::Simpson, threads);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  %u thread(s): %.17g  (error %.2e)  %.1f ms\n", threads, r, std::abs(r - exact), ms);
+    }
+    auto start = std::chrono::steady_clock::now();
+    double scalar_r = simpson(a, b, int(big_n));
+    double scalar_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  scalar simpson():  %.17g  (error %.2e)  %.1f ms\n\n", scalar_r, std::abs(scalar_r - exact), scalar_ms);
+
+    // Romberg: refine to a loose tolerance, then resume to a tight one; only new midpoints are evaluated
+    long calls = 0;
+    auto counted_exp = [&calls](double x) { ++calls; return std::exp(x); };
+    Romberg<decltype(counted_exp)> romberg(counted_exp, a, b);
+    std::cout << std::scientific << std::setprecision(3);
+    for (double tol : {1e-4, 1e-8, 1e-13}) {
+        IntegrationResult r = romberg.integrate(tol, 0);
+        std::cout << "Romberg to " << tol << ": value = " << std::setprecision(15) << std::fixed << r.value
+                  << std::scientific << std::setprecision(3) << ", error = " << std::abs(r.value - exact)
+                  << ", grid = " << r.intervals << " intervals, total evaluations = " << calls << '\n';
+    }
+    Romberg<decltype(counted_exp)> resumed(counted_exp, a, b, romberg.samples());
+    std::cout << "Rebuilt from " << romberg.samples().size() << " saved samples: value = "
+              << resumed.integrate(1e-13, 0).value - exact << " off, total evaluations still " << calls << '\n';
+    std::cout << "(trapezoidal at n = 10, 100, 1000 evaluates 11 + 101 + 1001 = 1113 points)\n\n";
+
+    // Adaptive Gauss-Kronrod: tolerance in, error estimate and evaluation count out
+    struct Case {
+        const char* name;
+        double (*fn)(double);
+        double a, b, exact;
+        bool singular;
+    };
+    const double inf = std::numeric_limits<double>::infinity();
+    const double pi = std::acos(-1.0);
+    Case cases[] = {
+        {"e^x on [0, 1]", [](double x) { return std::exp(x); }, 0, 1, std::exp(1.0) - 1, false},
+        {"1/sqrt(x) on [0, 1]", [](double x) { return 1 / std::sqrt(x); }, 0, 1, 2, false},
+        {"1/sqrt(x) on [0, 1], transformed", [](double x) { return 1 / std::sqrt(x); }, 0, 1, 2, true},
+        {"ln(x) on [0, 1], transformed", [](double x) { return std::log(x); }, 0, 1, -1, true},
+        {"e^(-x^2) on (-inf, inf)", [](double x) { return std::exp(-x * x); }, -inf, inf, std::sqrt(pi), false},
+        {"1/(1+x^2) on [0, inf)", [](double x) { return 1 / (1 + x * x); }, 0, inf, pi / 2, false},
+    };
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Adaptive Gauss-Kronrod (tolerance 1e-10)\n";
+    for (GaussKronrodRule rule : {GaussKronrodRule::GK15, GaussKronrodRule::GK21}) {
+        std::cout << (rule == GaussKronrodRule::GK15 ? "G7-K15" : "G10-K21") << ":\n";
+        for (const Case& c : cases) {
+            AdaptiveOptions opt;
+            opt.rule = rule;
+            opt.endpoint_singularities = c.singular;
+            IntegrationResult r = integrateAdaptive(c.fn, c.a, c.b, opt);
+            std::cout << "  " << std::left << std::setw(34) << c.name << std::right
+                      << " value = " << std::setprecision(12) << std::fixed << r.value
+                      << std::scientific << std::setprecision(3)
+                      << "  est. error = " << r.error << "  true error = " << std::abs(r.value - c.exact)
+                      << "  evaluations = " << r.evaluations << (r.converged ? "" : "  (not converged)") << '\n';
+        }
+    }
+
+    // Cubature over hyper-rectangles
+    std::cout << "\nCubature\n";
+    struct CubeCase {
+        const char* name;
+        size_t dim;
+        std::function<double(const double*)> fn;
+        double lo, hi, exact, tol;
+    };
+    const double erf1 = std::erf(1.0);
+    CubeCase cubes[] = {
+        {"e^(x+y+z) on [0,1]^3", 3, [](const double* x) { return std::exp(x[0] + x[1] + x[2]); },
+         0, 1, std::pow(std::exp(1.0) - 1, 3), 1e-8},
+        {"e^(-|x|^2) on [-1,1]^5", 5,
+         [](const double* x) { double r = 0; for (int i = 0; i < 5; ++i) r += x[i] * x[i]; return std::exp(-r); },
+         -1, 1, std::pow(std::sqrt(pi) * erf1, 5), 1e-6},
+        {"e^(mean x) on [0,1]^8", 8,
+         [](const double* x) { double r = 0; for (int i = 0; i < 8; ++i) r += x[i]; return std::exp(r / 8); },
+         0, 1, std::pow(8 * (std::exp(1.0 / 8) - 1), 8), 1e-8},
+        {"prod(1 + cos(x_i)/4) on [0,1]^10", 10,
+         [](const double* x) { double r = 1; for (int i = 0; i < 10; ++i) r *= 1 + std::cos(x[i]) / 4; return r; },
+         0, 1, std::pow(1 + std::sin(1.0) / 4, 10), 1e-8},
+    };
+    for (const CubeCase& c : cubes) {
+        for (unsigned threads : {1u, 4u}) {
+            CubatureOptions opt;
+            opt.threads = threads;
+            opt.abs_tol = opt.rel_tol = c.tol;
+            auto start = std::chrono::steady_clock::now();
+            IntegrationResult r = integrateCubature(batchedPoints(c.fn, c.dim), std::vector<double>(c.dim, c.lo),
+                                                    std::vector<double>(c.dim, c.hi), opt);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::printf("  %-34s tol %.0e  %-10s %u thr: value = %.12f  est. error = %.2e  true error = %.2e  "
+                        "evaluations = %ld  %s = %d  %.1f ms%s\n",
+                        c.name, c.tol, c.dim <= GENZ_MALIK_MAX_DIM ? "Genz-Malik" : "Smolyak", threads, r.value, r.error,
+                        std::abs(r.value - c.exact), r.evaluations, c.dim <= GENZ_MALIK_MAX_DIM ? "regions" : "level",
+                        r.intervals, ms, r.converged ? "" : "  (not converged)");
+        }
+    }
+
+    // Fixed-n Simpson needs this many evaluations to reach the same 1e-10 on e^x
+    int n_needed = 2;
+    while (std::abs(simpson(a, b, n_needed) - exact) > 1e-10) n_needed *= 2;
+    std::cout << "Simpson's rule needs n = " << n_needed << " (" << n_needed + 1
+              << " evaluations) for 1e-10 on e^x\n";
+
     return 0;
 }
@@ -5,86 +5,773 @@
 #include <array>
 #include <cmath>
 #include <cassert>
+#include <vector>
+#include <new>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 using namespace std;
 
+// ---------- Register-backed storage ----------
+
+// Storage behind Vector<T, N>: a plain array by default. Small float/double
+// vectors that fit one SSE/AVX register are padded to the register width,
+// with the padding lanes kept at zero.
+template<typename T, size_t N>
+struct VectorStorage {
+    array<T, N> v;
+};
+
+// Register kernels for the padded shapes; `enabled` is false everywhere else
+template<typename T, size_t N>
+struct RegisterOps {
+    static constexpr bool enabled = false;
+};
+
+#if defined(__SSE2__)
+template<> struct VectorStorage<float, 3> { alignas(16) array<float, 4> v; };
+template<> struct VectorStorage<float, 4> { alignas(16) array<float, 4> v; };
+template<> struct VectorStorage<double, 2> { alignas(16) array<double, 2> v; };
+
+// float3 and float4 share one __m128; float3 re-zeroes lane 3 on every store
+template<size_t N>
+struct FloatRegisterOps {
+    static constexpr bool enabled = true;
+    using R = __m128;
+    static R load(const float* p) { return _mm_load_ps(p); }
+    static void store(float* p, R r) {
+        if (N == 3) r = _mm_and_ps(r, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+        _mm_store_ps(p, r);
+    }
+    static R set1(float x) { return _mm_set1_ps(x); }
+    static R add(R a, R b) { return _mm_add_ps(a, b); }
+    static R sub(R a, R b) { return _mm_sub_ps(a, b); }
+    static R mul(R a, R b) { return _mm_mul_ps(a, b); }
+    static R div(R a, R b) { return _mm_div_ps(a, b); }
+    static float dot(R a, R b) {
+        R m = _mm_mul_ps(a, b);                                  // (x, y, z, w)
+        R s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1))); // (x+y, x+y, z+w, z+w)
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehl_ps(s, s)));
+    }
+    // a.yzx * b.zxy - a.zxy * b.yzx; the padding lane works out to 0
+    static R cross(R a, R b) {
+        R a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        R c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+};
+template<> struct RegisterOps<float, 3> : FloatRegisterOps<3> {};
+template<> struct RegisterOps<float, 4> : FloatRegisterOps<4> {};
+
+template<>
+struct RegisterOps<double, 2> {
+    static constexpr bool enabled = true;
+    using R = __m128d;
+    static R load(const double* p) { return _mm_load_pd(p); }
+    static void store(double* p, R r) { _mm_store_pd(p, r); }
+    static R set1(double x) { return _mm_set1_pd(x); }
+    static R add(R a, R b) { return _mm_add_pd(a, b); }
+    static R sub(R a, R b) { return _mm_sub_pd(a, b); }
+    static R mul(R a, R b) { return _mm_mul_pd(a, b); }
+    static R div(R a, R b) { return _mm_div_pd(a, b); }
+    static double dot(R a, R b) {
+        R m = _mm_mul_pd(a, b);
+        return _mm_cvtsd_f64(_mm_add_sd(m, _mm_unpackhi_pd(m, m)));
+    }
+};
+#endif
+
+#if defined(__AVX__)
+template<> struct VectorStorage<double, 4> { alignas(32) array<double, 4> v; };
+
+template<>
+struct RegisterOps<double, 4> {
+    static constexpr bool enabled = true;
+    using R = __m256d;
+    static R load(const double* p) { return _mm256_load_pd(p); }
+    static void store(double* p, R r) { _mm256_store_pd(p, r); }
+    static R set1(double x) { return _mm256_set1_pd(x); }
+    static R add(R a, R b) { return _mm256_add_pd(a, b); }
+    static R sub(R a, R b) { return _mm256_sub_pd(a, b); }
+    static R mul(R a, R b) { return _mm256_mul_pd(a, b); }
+    static R div(R a, R b) { return _mm256_div_pd(a, b); }
+    static double dot(R a, R b) {
+        R m = _mm256_mul_pd(a, b);
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+};
+#endif
+
+// ---------- Expression templates ----------
+
+template<typename T, size_t N> class Vector;
+
+struct VecExprTag {};
+
+// Base of every vector expression (CRTP). Arithmetic on expressions builds a
+// lightweight tree instead of temporaries; assigning it to a Vector evaluates
+// every element in one fused pass (or one register operation per node).
+template<typename E, typename T, size_t N>
+struct VecExpr : VecExprTag {
+    using value_type = T;
+    static constexpr size_t dimension = N;
+
+    const E& self() const { return static_cast<const E&>(*this); }
+    Vector<T, N> eval() const { return Vector<T, N>(*this); }
+
+    // Reductions and printing evaluate the expression first
+    template<typename E2> T dot(const VecExpr<E2, T, N>& other) const { return eval().dot(other.eval()); }
+    auto norm() const { return eval().norm(); }
+    void print() const { eval().print(); }
+};
+
+template<typename E>
+constexpr bool is_vec_expr = is_base_of_v<VecExprTag, decay_t<E>>;
+
+// Named operands are held by reference, temporaries by value, so an
+// expression saved with `auto` never points at a destroyed temporary
+template<typename E>
+using ExprOperand = conditional_t<is_lvalue_reference_v<E>, const decay_t<E>&, decay_t<E>>;
+
+struct AddOp {
+    template<typename X> static X apply(X a, X b) { return a + b; }
+    template<typename Ops, typename R> static R reg(R a, R b) { return Ops::add(a, b); }
+};
+struct SubOp {
+    template<typename X> static X apply(X a, X b) { return a - b; }
+    template<typename Ops, typename R> static R reg(R a, R b) { return Ops::sub(a, b); }
+};
+struct MulOp {
+    template<typename X> static X apply(X a, X b) { return a * b; }
+    template<typename Ops, typename R> static R reg(R a, R b) { return Ops::mul(a, b); }
+};
+struct DivOp {
+    template<typename X> static X apply(X a, X b) { return a / b; }
+    template<typename Ops, typename R> static R reg(R a, R b) { return Ops::div(a, b); }
+};
+
+// Elementwise l (op) r
+template<typename Op, typename L, typename R>
+struct VecBinary : VecExpr<VecBinary<Op, L, R>, typename decay_t<L>::value_type, decay_t<L>::dimension> {
+    using T = typename decay_t<L>::value_type;
+    static constexpr size_t N = decay_t<L>::dimension;
+    L l;
+    R r;
+    template<typename A, typename B>
+    VecBinary(A&& a, B&& b) : l(forward<A>(a)), r(forward<B>(b)) {}
+    T operator[](size_t i) const { return Op::apply(l[i], r[i]); }
+    auto reg() const { return Op::template reg<RegisterOps<T, N>>(l.reg(), r.reg()); }
+};
+
+// Elementwise e (op) s, or s (op) e when ScalarFirst
+template<typename Op, typename L, bool ScalarFirst = false>
+struct VecScalar : VecExpr<VecScalar<Op, L, ScalarFirst>, typename decay_t<L>::value_type, decay_t<L>::dimension> {
+    using T = typename decay_t<L>::value_type;
+    static constexpr size_t N = decay_t<L>::dimension;
+    L l;
+    T s;
+    template<typename A>
+    VecScalar(A&& a, T s) : l(forward<A>(a)), s(s) {}
+    T operator[](size_t i) const { return ScalarFirst ? Op::apply(s, l[i]) : Op::apply(l[i], s); }
+    auto reg() const {
+        using Ops = RegisterOps<T, N>;
+        return ScalarFirst ? Op::template reg<Ops>(Ops::set1(s), l.reg()) : Op::template reg<Ops>(l.reg(), Ops::set1(s));
+    }
+};
+
+template<typename L, typename R>
+using enable_if_exprs = enable_if_t<is_vec_expr<L> && is_vec_expr<R> &&
+                                    is_same_v<typename decay_t<L>::value_type, typename decay_t<R>::value_type> &&
+                                    decay_t<L>::dimension == decay_t<R>::dimension>;
+
+template<typename L, typename R, typename = enable_if_exprs<L, R>>
+auto operator+(L&& l, R&& r) { return VecBinary<AddOp, ExprOperand<L&&>, ExprOperand<R&&>>(forward<L>(l), forward<R>(r)); }
+
+template<typename L, typename R, typename = enable_if_exprs<L, R>>
+auto operator-(L&& l, R&& r) { return VecBinary<SubOp, ExprOperand<L&&>, ExprOperand<R&&>>(forward<L>(l), forward<R>(r)); }
+
+// Elementwise (Hadamard) product and quotient
+template<typename L, typename R, typename = enable_if_exprs<L, R>>
+auto operator*(L&& l, R&& r) { return VecBinary<MulOp, ExprOperand<L&&>, ExprOperand<R&&>>(forward<L>(l), forward<R>(r)); }
+
+template<typename L, typename R, typename = enable_if_exprs<L, R>>
+auto operator/(L&& l, R&& r) { return VecBinary<DivOp, ExprOperand<L&&>, ExprOperand<R&&>>(forward<L>(l), forward<R>(r)); }
+
+// Scaling by a scalar on either side, and division by a scalar
+template<typename L, typename = enable_if_t<is_vec_expr<L>>>
+auto operator*(L&& l, typename decay_t<L>::value_type s) { return VecScalar<MulOp, ExprOperand<L&&>>(forward<L>(l), s); }
+
+template<typename L, typename = enable_if_t<is_vec_expr<L>>>
+auto operator*(typename decay_t<L>::value_type s, L&& l) { return VecScalar<MulOp, ExprOperand<L&&>, true>(forward<L>(l), s); }
+
+template<typename L, typename = enable_if_t<is_vec_expr<L>>>
+auto operator/(L&& l, typename decay_t<L>::value_type s) { return VecScalar<DivOp, ExprOperand<L&&>>(forward<L>(l), s); }
+
 // Template class for an N-dimensional vector
 template<typename T, size_t N>
-class Vector {
+class Vector : public VecExpr<Vector<T, N>, T, N> {
 private:
-    array<T, N> data; // Stores the vector elements
+    VectorStorage<T, N> data; // Stores the vector elements (padded for register-backed shapes)
+    using Ops = RegisterOps<T, N>;
+
+    // Evaluates an expression into this vector: one register op per node for
+    // the padded shapes, otherwise every element is computed before any is
+    // stored, so the operands need not be reloaded in case they alias data
+    template<typename E, size_t... I>
+    void assignElements(const E& e, index_sequence<I...>) { data.v = array<T, N>{ e[I]... }; }
+
+    template<typename E>
+    void assign(const E& e) {
+        if constexpr (Ops::enabled) {
+            Ops::store(data.v.data(), e.reg());
+        } else {
+            assignElements(e, make_index_sequence<N>{});
+        }
+    }
 
 public:
+    // Floating-point type used for norm(): T itself for float/double, double for integers
+    using Real = conditional_t<is_floating_point_v<T>, T, double>;
+
     // Default constructor initializes all values to zero
-    Vector() { data.fill(T{}); }
+    Vector() { data.v.fill(T{}); }
 
     // Constructor that initializes values from a list
     Vector(const initializer_list<T>& list) {
         assert(list.size() == N); // Ensure correct size
+        data.v.fill(T{});
         size_t i = 0;
-        for (T val : list) data[i++] = val;
+        for (T val : list) data.v[i++] = val;
     }
 
-    // Allows accessing elements with indexing
-    T& operator[](size_t index) { return data[index]; }
-    const T& operator[](size_t index) const { return data[index]; }
+    // Evaluates any expression such as (v1 + v2) * s in a single pass
+    template<typename E>
+    Vector(const VecExpr<E, T, N>& e) { data.v.fill(T{}); assign(e.self()); }
 
-    // Adds two vectors element-wise
-    Vector<T, N> operator+(const Vector<T, N>& other) const {
-        Vector<T, N> result;
-        for (size_t i = 0; i < N; ++i)
-            result[i] = data[i] + other[i];
-        return result;
-    }
+    template<typename E>
+    Vector& operator=(const VecExpr<E, T, N>& e) { assign(e.self()); return *this; }
 
-    // Multiplies vector by a scalar
-    Vector<T, N> operator*(T scalar) const {
-        Vector<T, N> result;
-        for (size_t i = 0; i < N; ++i)
-            result[i] = data[i] * scalar;
-        return result;
-    }
+    template<typename E>
+    Vector& operator+=(const VecExpr<E, T, N>& e) { assign(*this + e.self()); return *this; }
+
+    template<typename E>
+    Vector& operator-=(const VecExpr<E, T, N>& e) { assign(*this - e.self()); return *this; }
+
+    Vector& operator*=(T scalar) { assign(*this * scalar); return *this; }
+
+    // Allows accessing elements with indexing
+    T& operator[](size_t index) { return data.v[index]; }
+    const T& operator[](size_t index) const { return data.v[index]; }
+
+    // Leaf of the register path
+    auto reg() const { return Ops::load(data.v.data()); }
 
     // Computes dot product between two vectors
     T dot(const Vector<T, N>& other) const {
-        T result = T{};
-        for (size_t i = 0; i < N; ++i)
-            result += data[i] * other[i];
-        return result;
+        if constexpr (Ops::enabled) {
+            return Ops::dot(reg(), other.reg());
+        } else {
+            T result = T{};
+            for (size_t i = 0; i < N; ++i)
+                result += data.v[i] * other[i];
+            return result;
+        }
     }
 
     // Computes cross product (only for 3D vectors)
     Vector<T, 3> cross(const Vector<T, 3>& other) const {
         static_assert(N == 3, "Cross product is defined only for 3D vectors.");
-        return Vector<T, 3>{
-            data[1] * other[2] - data[2] * other[1],
-            data[2] * other[0] - data[0] * other[2],
-            data[0] * other[1] - data[1] * other[0]
-        };
+        if constexpr (is_same_v<T, float> && RegisterOps<float, 3>::enabled) {
+            Vector<T, 3> result;
+            Ops::store(&result[0], Ops::cross(reg(), other.reg()));
+            return result;
+        } else {
+            return Vector<T, 3>{
+                data.v[1] * other[2] - data.v[2] * other[1],
+                data.v[2] * other[0] - data.v[0] * other[2],
+                data.v[0] * other[1] - data.v[1] * other[0]
+            };
+        }
     }
 
-    // Computes the magnitude (norm) of the vector
-    double norm() const {
-        T sum = T{};
-        for (T val : data) sum += val * val;
-        return sqrt(sum);
+    // Computes the magnitude (norm) of the vector, accumulating in Real so
+    // integer components cannot overflow and float stays single precision
+    Real norm() const {
+        if constexpr (Ops::enabled) {
+            return sqrt(dot(*this));
+        } else {
+            Real sum = Real{};
+            for (size_t i = 0; i < N; ++i) sum += Real(data.v[i]) * Real(data.v[i]);
+            return sqrt(sum);
+        }
     }
 
     // Returns a normalized (unit) version of the vector
     Vector<T, N> normalize() const {
-        double n = norm();
+        Real n = norm();
         assert(n != 0 && "Cannot normalize zero vector."); // Prevent division by zero
-        return (*this) * (1.0 / n);
+        return (*this) * T(1 / n);
     }
 
     // Prints the vector in (x, y, z) format
     void print() const {
         cout << "(";
         for (size_t i = 0; i < N; ++i)
-            cout << data[i] << (i < N - 1 ? ", " : "");
+            cout << data.v[i] << (i < N - 1 ? ", " : "");
         cout << ")";
     }
 };
 
+// ---------- Structure-of-arrays storage and SIMD kernels ----------
+
+// Allocator handing out Align-byte aligned blocks, so every column starts on a cache line
+template<typename T, size_t Align = 64>
+struct AlignedAllocator {
+    using value_type = T;
+    template<typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+    AlignedAllocator() = default;
+    template<typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+    T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(Align))); }
+    void deallocate(T* p, size_t) { ::operator delete(p, align_val_t(Align)); }
+    bool operator==(const AlignedAllocator&) const { return true; }
+    bool operator!=(const AlignedAllocator&) const { return false; }
+};
+
+// How VectorArray::normalize computes 1 / norm
+enum class NormalizeMode {
+    Exact,          // sqrt and divide
+    FastRsqrt,      // hardware reciprocal square root estimate only (12-14 bits)
+    FastRsqrtNewton // estimate refined by Newton steps y = y (1.5 - 0.5 x y^2) to near full precision
+};
+
+// One lane of T: the fallback for any T, and the tail of every SIMD loop
+template<typename T>
+struct ScalarOps {
+    using V = T;
+    static constexpr size_t width = 1;
+    static V load(const T* p) { return *p; }
+    static void store(T* p, V v) { *p = v; }
+    static V set1(T x) { return x; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V fmadd(V a, V b, V c) { return a * b + c; }
+    static V sqrt(V a) { return static_cast<T>(std::sqrt(a)); }
+    static V rsqrt(V a) { return static_cast<T>(1 / std::sqrt(a)); }
+    static T hsum(V a) { return a; }
+    static constexpr int newton_steps = 0; // rsqrt above is already exact
+};
+
+// The widest register set the compiler targets; other element types stay scalar
+template<typename T>
+struct SimdOps : ScalarOps<T> {};
+
+#if defined(__AVX512F__)
+// sqrt and rsqrt use the all-lanes maskz forms: same instructions, but GCC's
+// unmasked wrappers trip a false -Wuninitialized
+template<>
+struct SimdOps<double> {
+    using V = __m512d;
+    static constexpr size_t width = 8;
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V set1(double x) { return _mm512_set1_pd(x); }
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V sqrt(V a) { return _mm512_maskz_sqrt_pd(0xFF, a); }
+    static V rsqrt(V a) { return _mm512_maskz_rsqrt14_pd(0xFF, a); }
+    static double hsum(V a) {
+        alignas(64) double t[8];
+        _mm512_store_pd(t, a);
+        return ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+    }
+    static constexpr int newton_steps = 2; // 14 -> 28 -> 52 bits
+};
+
+template<>
+struct SimdOps<float> {
+    using V = __m512;
+    static constexpr size_t width = 16;
+    static V load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, V v) { _mm512_storeu_ps(p, v); }
+    static V set1(float x) { return _mm512_set1_ps(x); }
+    static V add(V a, V b) { return _mm512_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm512_div_ps(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+    static V sqrt(V a) { return _mm512_maskz_sqrt_ps(0xFFFF, a); }
+    static V rsqrt(V a) { return _mm512_maskz_rsqrt14_ps(0xFFFF, a); }
+    static float hsum(V a) {
+        alignas(64) float t[16];
+        _mm512_store_ps(t, a);
+        float s = 0;
+        for (float x : t) s += x;
+        return s;
+    }
+    static constexpr int newton_steps = 1; // 14 -> 24 bits
+};
+#elif defined(__AVX2__) && defined(__FMA__)
+template<>
+struct SimdOps<double> {
+    using V = __m256d;
+    static constexpr size_t width = 4;
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double x) { return _mm256_set1_pd(x); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    // AVX2 has no double rsqrt: take the float estimate and widen it. a is
+    // first scaled by 4^-k into [1, 4), where float cannot overflow or
+    // flush, and the estimate is scaled back by 2^-k, all on the exponent
+    // bits. Zero, subnormal, inf and NaN lanes have no such exponent, so a
+    // vector holding any of them takes 1 / sqrt.
+    static V rsqrt(V a) {
+        const __m256i biased = _mm256_srli_epi64(_mm256_castpd_si256(a), 52);
+        const __m256i e = _mm256_and_si256(biased, _mm256_set1_epi64x(0x7FF));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi64(e, _mm256_setzero_si256()),
+                                                _mm256_cmpeq_epi64(e, _mm256_set1_epi64x(0x7FF)));
+        if (_mm256_movemask_pd(_mm256_castsi256_pd(special)))
+            return _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(a));
+        // 2k = e - 1023 rounded down to even: the scaled exponent is 1023 or 1024
+        const __m256i two_k = _mm256_sub_epi64(e, _mm256_sub_epi64(_mm256_set1_epi64x(1024),
+                                                                   _mm256_and_si256(e, _mm256_set1_epi64x(1))));
+        const __m256d scaled = _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_castpd_si256(a), _mm256_slli_epi64(two_k, 52)));
+        const __m256d y = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(scaled)));
+        return _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_castpd_si256(y), _mm256_slli_epi64(two_k, 51)));
+    }
+    static double hsum(V a) {
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+    static constexpr int newton_steps = 3; // 12 -> 24 -> 48 -> 53 bits
+};
+
+template<>
+struct SimdOps<float> {
+    using V = __m256;
+    static constexpr size_t width = 8;
+    static V load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+    static V set1(float x) { return _mm256_set1_ps(x); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static V rsqrt(V a) { return _mm256_rsqrt_ps(a); }
+    static float hsum(V a) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehdup_ps(s)));
+    }
+    static constexpr int newton_steps = 1; // 12 -> 24 bits
+};
+#endif
+
+// Many N-dimensional vectors stored as N aligned columns (structure of arrays):
+// column k holds component k of every vector, so one SIMD register processes
+// several vectors at once with no shuffling. Bulk operations run the widest
+// SimdOps<T> kernel over whole registers and a scalar loop over the tail.
+template<typename T, size_t N>
+class VectorArray {
+private:
+    array<vector<T, AlignedAllocator<T>>, N> cols; // cols[k][i] is component k of vector i
+
+    // Calls body(ops, i) for every register-sized block, then every leftover index
+    template<typename Body>
+    void blocks(size_t n, Body body) const {
+        size_t i = 0;
+        for (; i + SimdOps<T>::width <= n; i += SimdOps<T>::width) body(SimdOps<T>{}, i);
+        for (; i < n; ++i) body(ScalarOps<T>{}, i);
+    }
+
+public:
+    VectorArray() = default;
+    explicit VectorArray(size_t n) { resize(n); }
+
+    // From and to array-of-structs
+    explicit VectorArray(const vector<Vector<T, N>>& vs) {
+        resize(vs.size());
+        for (size_t i = 0; i < vs.size(); ++i) set(i, vs[i]);
+    }
+
+    vector<Vector<T, N>> toVectors() const {
+        vector<Vector<T, N>> vs(size());
+        for (size_t i = 0; i < size(); ++i) vs[i] = get(i);
+        return vs;
+    }
+
+    size_t size() const { return cols[0].size(); }
+    void resize(size_t n) { for (auto& c : cols) c.resize(n, T{}); }
+
+    void push_back(const Vector<T, N>& v) { for (size_t k = 0; k < N; ++k) cols[k].push_back(v[k]); }
+
+    Vector<T, N> get(size_t i) const {
+        Vector<T, N> v;
+        for (size_t k = 0; k < N; ++k) v[k] = cols[k][i];
+        return v;
+    }
+
+    void set(size_t i, const Vector<T, N>& v) { for (size_t k = 0; k < N; ++k) cols[k][i] = v[k]; }
+
+    T* column(size_t k) { return cols[k].data(); }
+    const T* column(size_t k) const { return cols[k].data(); }
+
+    // out[i] = this[i] . other[i]
+    void dot(const VectorArray& other, T* out) const {
+        assert(other.size() == size());
+        blocks(size(), [&](auto ops, size_t i) {
+            using S = decltype(ops);
+            auto acc = S::mul(S::load(&cols[0][i]), S::load(&other.cols[0][i]));
+            for (size_t k = 1; k < N; ++k) acc = S::fmadd(S::load(&cols[k][i]), S::load(&other.cols[k][i]), acc);
+            S::store(out + i, acc);
+        });
+    }
+
+    // out[i] = |this[i]|
+    void norm(T* out) const {
+        blocks(size(), [&](auto ops, size_t i) {
+            using S = decltype(ops);
+            auto acc = S::mul(S::load(&cols[0][i]), S::load(&cols[0][i]));
+            for (size_t k = 1; k < N; ++k) acc = S::fmadd(S::load(&cols[k][i]), S::load(&cols[k][i]), acc);
+            S::store(out + i, S::sqrt(acc));
+        });
+    }
+
+    // out[i] = this[i] x other[i] (3-D only)
+    void cross(const VectorArray& other, VectorArray& out) const {
+        static_assert(N == 3, "Cross product is defined only for 3D vectors.");
+        assert(other.size() == size());
+        out.resize(size());
+        blocks(size(), [&](auto ops, size_t i) {
+            using S = decltype(ops);
+            auto ax = S::load(&cols[0][i]), ay = S::load(&cols[1][i]), az = S::load(&cols[2][i]);
+            auto bx = S::load(&other.cols[0][i]), by = S::load(&other.cols[1][i]), bz = S::load(&other.cols[2][i]);
+            S::store(&out.cols[0][i], S::sub(S::mul(ay, bz), S::mul(az, by)));
+            S::store(&out.cols[1][i], S::sub(S::mul(az, bx), S::mul(ax, bz)));
+            S::store(&out.cols[2][i], S::sub(S::mul(ax, by), S::mul(ay, bx)));
+        });
+    }
+
+    // Scales every vector to unit length in place. Zero vectors are not allowed,
+    // as with Vector::normalize.
+    void normalize(NormalizeMode mode = NormalizeMode::Exact) {
+        blocks(size(), [&](auto ops, size_t i) {
+            using S = decltype(ops);
+            auto sq = S::mul(S::load(&cols[0][i]), S::load(&cols[0][i]));
+            for (size_t k = 1; k < N; ++k) sq = S::fmadd(S::load(&cols[k][i]), S::load(&cols[k][i]), sq);
+            decltype(sq) inv;
+            if (mode == NormalizeMode::Exact) {
+                inv = S::div(S::set1(T(1)), S::sqrt(sq));
+            } else {
+                inv = S::rsqrt(sq);
+                if (mode == NormalizeMode::FastRsqrtNewton)
+                    for (int step = 0; step < S::newton_steps; ++step) {  // x y first: y^2 overflows for subnormal x
+                        auto half_x_y2 = S::mul(S::mul(S::mul(S::set1(T(0.5)), sq), inv), inv);
+                        inv = S::mul(inv, S::sub(S::set1(T(1.5)), half_x_y2));
+                    }
+            }
+            for (size_t k = 0; k < N; ++k) S::store(&cols[k][i], S::mul(S::load(&cols[k][i]), inv));
+        });
+    }
+
+    // this[i] += a * x[i]
+    void axpy(T a, const VectorArray& x) {
+        assert(x.size() == size());
+        for (size_t k = 0; k < N; ++k) {
+            T* y = cols[k].data();
+            const T* xs = x.cols[k].data();
+            blocks(size(), [&](auto ops, size_t i) {
+                using S = decltype(ops);
+                S::store(y + i, S::fmadd(S::set1(a), S::load(xs + i), S::load(y + i)));
+            });
+        }
+    }
+
+    // Sum of all vectors, accumulated per register lane and folded at the end
+    Vector<T, N> sum() const {
+        Vector<T, N> total;
+        for (size_t k = 0; k < N; ++k) {
+            using S = SimdOps<T>;
+            auto acc = S::set1(T{});
+            size_t i = 0;
+            for (; i + S::width <= size(); i += S::width) acc = S::add(acc, S::load(&cols[k][i]));
+            T t = S::hsum(acc);
+            for (; i < size(); ++i) t += cols[k][i];
+            total[k] = t;
+        }
+        return total;
+    }
+
+    // Sum over i of this[i] . other[i]
+    T dotSum(const VectorArray& other) const {
+        assert(other.size() == size());
+        using S = SimdOps<T>;
+        auto acc = S::set1(T{});
+        size_t i = 0;
+        for (; i + S::width <= size(); i += S::width)
+            for (size_t k = 0; k < N; ++k) acc = S::fmadd(S::load(&cols[k][i]), S::load(&other.cols[k][i]), acc);
+        T t = S::hsum(acc);
+        for (; i < size(); ++i)
+            for (size_t k = 0; k < N; ++k) t += cols[k][i] * other.cols[k][i];
+        return t;
+    }
+};
+
+// Times one bulk kernel against the same work as a loop over Vector, in vectors per second
+template<typename T>
+void benchmarkVectorArray(const char* type_name, size_t count) {
+    mt19937 rng(7);
+    uniform_real_distribution<double> unit(-1.0, 1.0);
+    vector<Vector<T, 3>> a(count), b(count);
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = Vector<T, 3>{T(unit(rng)), T(unit(rng)), T(unit(rng) + 2)};
+        b[i] = Vector<T, 3>{T(unit(rng)), T(unit(rng)), T(unit(rng))};
+    }
+    VectorArray<T, 3> sa(a), sb(b), sc;
+    vector<T> out(count);
+    vector<Vector<T, 3>> aos_out(count);
+
+    auto rate = [&](auto&& body) {
+        auto start = chrono::steady_clock::now();
+        int reps = 0;
+        do {
+            body();
+            ++reps;
+        } while (chrono::steady_clock::now() - start < chrono::milliseconds(200));
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return count * reps / secs / 1e6;
+    };
+    auto report = [&](const char* op, double aos, double soa, const char* note = "") {
+        printf("  %-6s %-26s Vector loop %8.1f M/s   VectorArray %8.1f M/s   x%.1f%s\n",
+               type_name, op, aos, soa, soa / aos, note);
+    };
+
+    report("dot", rate([&]() { for (size_t i = 0; i < count; ++i) out[i] = a[i].dot(b[i]); }),
+           rate([&]() { sa.dot(sb, out.data()); }));
+    report("cross", rate([&]() { for (size_t i = 0; i < count; ++i) aos_out[i] = a[i].cross(b[i]); }),
+           rate([&]() { sa.cross(sb, sc); }));
+    report("axpy", rate([&]() { for (size_t i = 0; i < count; ++i) aos_out[i] = aos_out[i] + b[i] * T(0.5); }),
+           rate([&]() { sc.axpy(T(0.5), sb); }));
+
+    double aos_norm = rate([&]() { for (size_t i = 0; i < count; ++i) aos_out[i] = a[i].normalize(); });
+    for (NormalizeMode mode : {NormalizeMode::Exact, NormalizeMode::FastRsqrt, NormalizeMode::FastRsqrtNewton}) {
+        double soa = rate([&]() { sc = sa; sc.normalize(mode); });
+        double worst = 0;
+        sc.norm(out.data());
+        for (size_t i = 0; i < count; ++i) worst = max(worst, fabs(double(out[i]) - 1));
+        char note[64];
+        snprintf(note, sizeof note, "   max | |v| - 1 | = %.1e", worst);
+        const char* name = mode == NormalizeMode::Exact ? "normalize (exact)"
+                         : mode == NormalizeMode::FastRsqrt ? "normalize (rsqrt)" : "normalize (rsqrt + Newton)";
+        report(name, aos_norm, soa, note);
+    }
+}
+
+// ---------- Per-operation cycle counts ----------
+
+// The original eager operators, kept as the "before" side of the benchmark:
+// every operator returns a new array-backed vector
+template<typename T, size_t N>
+struct EagerVector {
+    array<T, N> data{};
+    T& operator[](size_t i) { return data[i]; }
+    const T& operator[](size_t i) const { return data[i]; }
+    EagerVector operator+(const EagerVector& o) const { EagerVector r; for (size_t i = 0; i < N; ++i) r[i] = data[i] + o[i]; return r; }
+    EagerVector operator-(const EagerVector& o) const { EagerVector r; for (size_t i = 0; i < N; ++i) r[i] = data[i] - o[i]; return r; }
+    EagerVector operator*(const EagerVector& o) const { EagerVector r; for (size_t i = 0; i < N; ++i) r[i] = data[i] * o[i]; return r; }
+    EagerVector operator*(T s) const { EagerVector r; for (size_t i = 0; i < N; ++i) r[i] = data[i] * s; return r; }
+    T dot(const EagerVector& o) const { T r = T{}; for (size_t i = 0; i < N; ++i) r += data[i] * o[i]; return r; }
+    double norm() const { T sum = T{}; for (T v : data) sum += v * v; return sqrt(sum); }
+    EagerVector cross(const EagerVector& o) const {
+        EagerVector r;
+        r[0] = data[1] * o[2] - data[2] * o[1];
+        r[1] = data[2] * o[0] - data[0] * o[2];
+        r[2] = data[0] * o[1] - data[1] * o[0];
+        return r;
+    }
+};
+
+// Time-stamp counter ticks (nanoseconds where there is no TSC)
+inline uint64_t cycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return uint64_t(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Average ticks per call of op(a[i], b[i], c[i], out[i]) over a cache-resident batch
+template<typename V, typename Op>
+double cyclesPerOp(vector<V>& a, vector<V>& b, vector<V>& c, vector<V>& out, Op op) {
+    const int reps = 200;
+    uint64_t best = ~uint64_t(0);
+    for (int round = 0; round < 5; ++round) {
+        uint64_t start = cycleCount();
+        for (int r = 0; r < reps; ++r)
+            for (size_t i = 0; i < a.size(); ++i) op(a[i], b[i], c[i], out[i]);
+        best = min(best, cycleCount() - start);
+    }
+    return double(best) / (double(reps) * a.size());
+}
+
+template<typename T, size_t N>
+void benchmarkVectorOps(const char* name) {
+    const size_t count = 1024;
+    mt19937 rng(11);
+    uniform_real_distribution<double> unit(0.5, 2.0);
+    vector<EagerVector<T, N>> ea(count), eb(count), ec(count), eo(count);
+    vector<Vector<T, N>> va(count), vb(count), vc(count), vo(count);
+    for (size_t i = 0; i < count; ++i)
+        for (size_t k = 0; k < N; ++k) {
+            ea[i][k] = va[i][k] = T(unit(rng));
+            eb[i][k] = vb[i][k] = T(unit(rng));
+            ec[i][k] = vc[i][k] = T(unit(rng));
+        }
+    T s = T(1.5);
+    vector<T> scalars(count); // per-element results for dot/norm, so calls stay independent
+
+    auto row = [&](const char* op, double before, double after) {
+        printf("  %-9s %-20s %6.2f -> %6.2f   x%.1f\n", name, op, before, after, before / after);
+    };
+    row("(a + b) * s",
+        cyclesPerOp(ea, eb, ec, eo, [&](auto& a, auto& b, auto&, auto& o) { o = (a + b) * s; }),
+        cyclesPerOp(va, vb, vc, vo, [&](auto& a, auto& b, auto&, auto& o) { o = (a + b) * s; }));
+    row("a - b * c (elemwise)",
+        cyclesPerOp(ea, eb, ec, eo, [&](auto& a, auto& b, auto& c, auto& o) { o = a - b * c; }),
+        cyclesPerOp(va, vb, vc, vo, [&](auto& a, auto& b, auto& c, auto& o) { o = a - b * c; }));
+    row("dot",
+        cyclesPerOp(ea, eb, ec, eo, [&](auto& a, auto& b, auto&, auto&) { scalars[&a - ea.data()] = a.dot(b); }),
+        cyclesPerOp(va, vb, vc, vo, [&](auto& a, auto& b, auto&, auto&) { scalars[&a - va.data()] = a.dot(b); }));
+    row("norm",
+        cyclesPerOp(ea, eb, ec, eo, [&](auto& a, auto&, auto&, auto&) { scalars[&a - ea.data()] = T(a.norm()); }),
+        cyclesPerOp(va, vb, vc, vo, [&](auto& a, auto&, auto&, auto&) { scalars[&a - va.data()] = T(a.norm()); }));
+    if constexpr (N == 3)
+        row("cross",
+            cyclesPerOp(ea, eb, ec, eo, [&](auto& a, auto& b, auto&, auto& o) { o = a.cross(b); }),
+            cyclesPerOp(va, vb, vc, vo, [&](auto& a, auto& b, auto&, auto& o) { o = a.cross(b); }));
+}
+
 // ---------- Test Cases ----------
 int main() {
     Vector<double, 3> v1{5.0, 7.0, 2.0}; // Define a 3D vector
@@ -114,5 +801,31 @@ int main() {
     auto unit = v1.normalize();
     cout << "v1 normalized = "; unit.print(); cout << endl;
 
+    // Structure-of-arrays container: the same operations on many vectors at once
+    VectorArray<double, 3> arr(vector<Vector<double, 3>>{v1, v2, cross});
+    VectorArray<double, 3> other(vector<Vector<double, 3>>{v2, v1, v1});
+    double dots[3];
+    arr.dot(other, dots);
+    cout << "\nVectorArray dots = " << dots[0] << ", " << dots[1] << ", " << dots[2] << endl;
+    cout << "VectorArray sum = "; arr.sum().print(); cout << endl;
+    arr.normalize();
+    cout << "VectorArray[0] normalized = "; arr.get(0).print(); cout << endl;
+
+    // Throughput on 16K 3-D vectors: small enough to stay in cache, so the
+    // kernels are measured rather than memory bandwidth
+    cout << "\nBulk throughput, 16K vectors (" << SimdOps<double>::width << " doubles / "
+         << SimdOps<float>::width << " floats per register):\n";
+    benchmarkVectorArray<double>("double", 1 << 14);
+    benchmarkVectorArray<float>("float", 1 << 14);
+
+    // Expression templates and register-backed shapes: ticks per operation,
+    // original eager operators -> current Vector
+    cout << "\nTicks per operation, eager operators -> expression templates:\n";
+    benchmarkVectorOps<float, 3>("float3");
+    benchmarkVectorOps<float, 4>("float4");
+    benchmarkVectorOps<double, 2>("double2");
+    benchmarkVectorOps<double, 3>("double3");
+    benchmarkVectorOps<double, 4>("double4");
+
     return 0; // Successful execution
 }